@@ -0,0 +1,515 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas-haywood-loop.c
+ Author      : Matthias Thimm
+ Version     : 1.10
+ Copyright   : GPL3
+ Description : The main loop of the local search of taas-haywood. This file is
+               included several times by taas-haywood.c, each time defining a
+               function SLS_NAME. The following macros select the options of
+               that variant; each is either a compile-time constant (so the
+               compiler removes the corresponding branches) or an expression
+               over "aaf", "params", and "occ" evaluated at runtime:
+               SLS_DENSE        use the adjacency bit matrices
+               SLS_LOCMINRES    restart in local minima ("-locminres")
+               SLS_GREEDY       greedy moves ("-greedyprob")
+               SLS_GREEDYINCALL greedy moves on all arguments ("-greedyincall")
+               SLS_RANDSEL      arbitrary random moves ("-randsel")
+               SLS_ENFORCEOUT   enforce out-labels around in-labels ("-enforceout")
+               SLS_OCC          escape odd cycles ("-escapeoddcycles")
+               SLS_INITOUT      initialise with the all-out labeling ("-initout")
+               SLS_LNS          repair stagnating regions exactly ("-lns")
+               SLS_TABU         forbid flipping recently flipped arguments ("-tabu")
+               SLS_NOISE        adapt the probability of random moves ("-adaptivenoise")
+               SLS_WEIGHTED     weight arguments mislabeled in local minima ("-weighted")
+               SLS_CC           configuration checking ("-cc")
+               SLS_PROBSAT      sample random moves by their flipping counts ("-probsat")
+               The macros are undefined at the end of this file.
+ ============================================================================
+ */
+
+/**
+ * Runs the local search on the given AAF (the residual of the original AAF
+ * wrt. the grounded labeling, i.e., every argument is undecided in the grounded
+ * labeling); returns TRUE iff a stable labeling has been found (which is then
+ * contained in lab).
+ */
+int SLS_NAME(struct AAF* aaf, struct SearchParameters* params, struct OddCycleCollection* occ, struct Rng* rng, struct Labeling* lab){
+  // all data structures of the search are allocated from this arena
+  struct Arena* arena = arena__init();
+  // in order to have pointers to the arguments
+  int* all_arguments = aaf->arguments;
+  float log_b = 0;
+  if(SLS_LOCMINRES)
+    log_b = 1/log(params->locminres);
+  // The following data structure keeps track of the arguments that are not labeled correctly
+  struct RaSet* mislabeled = raset__init_empty_in(aaf->number_of_arguments, arena);
+  // The following data structure collects arguments that have to be checked for their
+  // correct label after some change
+  struct RaSet* toBeChecked = raset__init_empty_in(aaf->number_of_arguments, arena);
+  // buffers for the bulk verifier
+  struct BitSet* attacked = bitset__init_in(aaf->number_of_arguments, arena);
+  struct BitSet* attacking = bitset__init_in(aaf->number_of_arguments, arena);
+  // the following  heap is used as a priority queue if greedy choices are enabled,
+  // i.e. it records for arguments their flipping number;
+  // for each argument currently correctly labeled +1 is added; for each
+  // argument labeled correctly after flipping -1 is added; thus, the smaller
+  // the number, the better the flip
+  struct BinaryHeap* mislabeled_pqueue = NULL;
+  if(SLS_GREEDY){
+    mislabeled_pqueue = malloc(sizeof(struct BinaryHeap));
+    binaryheap__init(mislabeled_pqueue, aaf->number_of_arguments);
+  }
+  // the following ints remember the global minimum of the number of mislabeled arguments (so far);
+  // only used if locminres > 0
+  int min_mislabeled = INT_MAX;
+  long min_mislabeled_iteration = 0;
+  // the same since the last restart or repair, for detecting stagnation,
+  // and the number of stagnating iterations before a repair (initially
+  // "lns", doubled after every failed repair); only used if lns > 0
+  int lns_min_mislabeled = INT_MAX;
+  long lns_min_mislabeled_iteration = 0;
+  long lns_interval = params->lns;
+  struct Lns* lns = NULL;
+  if(SLS_LNS)
+    lns = taas__lns_init(aaf,arena);
+  // the iteration until which each argument must not be flipped again;
+  // only used if tabu > 0
+  long* tabu_until = NULL;
+  if(SLS_TABU)
+    tabu_until = arena__calloc(arena, aaf->number_of_arguments * sizeof(long));
+  // the arguments some neighbour of which has been flipped since their
+  // last flip (configuration checking); only used if cc is set
+  struct BitSet* cc_changed = NULL;
+  if(SLS_CC)
+    cc_changed = bitset__init_in(aaf->number_of_arguments, arena);
+  // the cached flipping counts (valid for the arguments in score_valid; the
+  // flipping count of an argument depends on the labels within distance 2,
+  // so a flip invalidates the checked arguments and their neighbours) and
+  // the buffers for sampling among the candidates; only used if probsat > 0
+  int* scores = NULL;
+  struct BitSet* score_valid = NULL;
+  int* probsat_candidates = NULL;
+  double* probsat_weights = NULL;
+  if(SLS_PROBSAT){
+    scores = arena__alloc(arena, aaf->number_of_arguments * sizeof(int));
+    score_valid = bitset__init_in(aaf->number_of_arguments, arena);
+    bitset__unsetAll(score_valid);
+    probsat_candidates = arena__alloc(arena, (2 * (long)aaf->number_of_arguments + 1) * sizeof(int));
+    probsat_weights = arena__alloc(arena, (2 * (long)aaf->number_of_arguments + 1) * sizeof(double));
+  }
+  // the global minimum of the number of mislabeled arguments; an argument
+  // that is tabu or whose configuration has not changed may be flipped if
+  // this gives a new global minimum
+  int best_mislabeled = INT_MAX;
+  // the probabilities of greedy moves and of arbitrary random moves; with
+  // adaptive noise they are 1-noise and the share of "randsel" in the
+  // random moves times noise, where the noise is raised if the number of
+  // mislabeled arguments has not decreased for adaptivenoise*n iterations
+  // since the last adaptation and lowered whenever it decreases
+  float greedyprob = params->greedyprob;
+  float randsel = params->randsel;
+  float noise = 1 - params->greedyprob;
+  float randsel_share = params->greedyprob < 1 ? params->randsel / (1 - params->greedyprob) : 0;
+  if(randsel_share > 1)
+    randsel_share = 1;
+  int noise_mislabeled = INT_MAX;
+  long noise_iteration = 0;
+  // the weight of each argument (initially 1), which is increased whenever
+  // the argument is mislabeled in a local minimum (no greedy move decreases
+  // the weighted number of mislabeled arguments); every "weighted"-th
+  // increase all weights above 1 are decreased by 1 (smoothing);
+  // only used if weighted > 0
+  int* weights = NULL;
+  struct RaSet* heavy = NULL;
+  int max_weight = 1;
+  long weight_increases = 0;
+  if(SLS_WEIGHTED){
+    weights = arena__alloc(arena, aaf->number_of_arguments * sizeof(int));
+    for(int i = 0; i < aaf->number_of_arguments; i++)
+      weights[i] = 1;
+    heavy = raset__init_empty_in(aaf->number_of_arguments, arena);
+  }
+  // the labeling with the fewest mislabeled arguments (if params->best is not NULL)
+  struct BestLabeling* best = NULL;
+  if(params->best != NULL)
+    best = best_labeling__init(params->best, arena);
+  // the following parameter keeps track of the number of iterations;
+  // the search is aborted once the maximal number of iterations is reached;
+  // then "NO" is returned (meaning no stable labeling "likely" exists)
+  long number_iterations = 0;
+  //------------------
+  // MAIN LOOP - BEGIN
+  //------------------
+  do{
+    // check if we need to restart because we think we are in a local minimum
+    int force_restart = FALSE;
+    if(SLS_LOCMINRES){
+      // update current global minimum
+      if(mislabeled->number_of_elements < min_mislabeled){
+        min_mislabeled = mislabeled->number_of_elements;
+        min_mislabeled_iteration = number_iterations;
+      }else{
+        float prob = 1-log_b/log(number_iterations-min_mislabeled_iteration+params->locminres);
+        if(rng__double(rng) < prob)
+          force_restart = TRUE;
+      }
+    }
+    // whenever the restart parameter says so (or force_restart), randomise the labeling
+    int rebuild_pqueue = FALSE;
+    if((number_iterations == 0) || (params->restart != -1 && (number_iterations % params->restart) == 0) || force_restart){
+      if(SLS_INITOUT){
+        // use the all-out labeling
+        bitset__unsetAll(lab->in);
+      }else taas__lab_randomize(lab,rng);
+      // reset mislabeled data structures
+      raset__reset(mislabeled);
+      taas__compute_mislabeled(aaf,lab->in,NULL,attacked,attacking,mislabeled,params->threads);
+      // if we already have a stable labeling, break
+      if(mislabeled->number_of_elements == 0)
+        break;
+      // store minimum mislabeled number
+      if(SLS_LOCMINRES){
+        min_mislabeled = mislabeled->number_of_elements;
+        min_mislabeled_iteration = 0;
+      }
+      if(SLS_LNS){
+        lns_min_mislabeled = mislabeled->number_of_elements;
+        lns_min_mislabeled_iteration = number_iterations;
+      }
+      if(SLS_NOISE){
+        noise_mislabeled = mislabeled->number_of_elements;
+        noise_iteration = number_iterations;
+      }
+      if(SLS_CC)
+        bitset__setAll(cc_changed);
+      if(best != NULL)
+        best->full = TRUE;
+      rebuild_pqueue = TRUE;
+    }
+    // in a local minimum, increase the weights of the mislabeled arguments
+    // (and smooth them); this changes the flipping numbers of the arguments
+    // and their neighbours, which are updated in the heap
+    if(SLS_WEIGHTED && !rebuild_pqueue && mislabeled_pqueue->length > 0 && binaryheap__value_of_minimum(mislabeled_pqueue) >= 0){
+      for(int i = 0; i < mislabeled->number_of_elements; i++){
+        int elem = raset__get(mislabeled,i);
+        if(weights[elem] == 1)
+          raset__add(heavy,elem);
+        change_weight(aaf,lab,elem,1,SLS_DENSE,weights,mislabeled_pqueue,all_arguments,score_valid);
+        if(weights[elem] > max_weight)
+          max_weight = weights[elem];
+      }
+      if(++weight_increases % params->weighted == 0){
+        max_weight = 1;
+        for(int i = heavy->number_of_elements - 1; i >= 0; i--){
+          int elem = raset__get(heavy,i);
+          change_weight(aaf,lab,elem,-1,SLS_DENSE,weights,mislabeled_pqueue,all_arguments,score_valid);
+          if(weights[elem] == 1)
+            raset__remove(heavy,elem);
+          else if(weights[elem] > max_weight)
+            max_weight = weights[elem];
+        }
+      }
+    }
+    if(SLS_PROBSAT && rebuild_pqueue)
+      bitset__unsetAll(score_valid);
+    // reset greedy choice datastructures, if needed
+    if(SLS_GREEDY && rebuild_pqueue){
+      // empty the heap
+      binaryheap__reset(mislabeled_pqueue);
+      // determine for each mislabeled argument (if greedyincall = false) or
+      // for each argument (if greedyincall = true) its "flipping number"
+      if(SLS_GREEDYINCALL)
+        for(int i = 0; i < aaf->number_of_arguments; i++)
+          binaryheap__insert(mislabeled_pqueue,&all_arguments[i],get_flipping_count(aaf,lab,i,SLS_DENSE,weights));
+      else
+        for(int i = 0; i < mislabeled->number_of_elements; i++){
+          int elem = raset__get(mislabeled,i);
+          binaryheap__insert(mislabeled_pqueue,&all_arguments[elem],get_flipping_count(aaf,lab,elem,SLS_DENSE,weights));
+        }
+    }
+    if(best != NULL)
+      best_labeling__update(best, lab->in, mislabeled->number_of_elements);
+    // check iteration count
+    number_iterations++;
+    if(number_iterations >= params->max_iterations)
+      break;
+    // another search (on another component) has already failed
+    if(params->stop != NULL && __atomic_load_n(params->stop,__ATOMIC_RELAXED))
+      break;
+    // reset toBeChecked
+    raset__reset(toBeChecked);
+    // if the number of mislabeled arguments has not decreased for "lns"
+    // iterations, relabel the region around them exactly
+    int repaired = FALSE;
+    // the argument flipped in this iteration (if any)
+    int flipped = -1;
+    if(SLS_LNS){
+      if(mislabeled->number_of_elements < lns_min_mislabeled){
+        lns_min_mislabeled = mislabeled->number_of_elements;
+        lns_min_mislabeled_iteration = number_iterations;
+      }else if(number_iterations - lns_min_mislabeled_iteration >= lns_interval){
+        lns_min_mislabeled_iteration = number_iterations;
+        if(mislabeled->number_of_elements <= LNS_MAX_MISLABELED){
+          repaired = taas__lns_repair(aaf,lab->in,mislabeled,params->lnsradius,lns);
+          lns_interval = repaired ? params->lns : 2 * lns_interval;
+        }
+      }
+    }
+    if(repaired){
+      // the region and its neighbourhood have to be checked
+      for(int i = 0; i < lns->region->number_of_elements; i++){
+        int arg = raset__get(lns->region,i);
+        if(best != NULL)
+          best_labeling__log(best, arg);
+        raset__add(toBeChecked,arg);
+        for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+          raset__add(toBeChecked,aaf->children_arr[k]);
+        for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+          raset__add(toBeChecked,aaf->parents_arr[k]);
+      }
+    }else{
+      //pick 1.) a mislabled argument at random or
+      // 2.) do a greedy move, or
+      // 3.) pick an arbitrary argument at random
+      int sel_arg;
+      if((SLS_TABU || SLS_CC) && mislabeled->number_of_elements < best_mislabeled)
+        best_mislabeled = mislabeled->number_of_elements;
+      if(SLS_NOISE){
+        int adapted = FALSE;
+        if(mislabeled->number_of_elements < noise_mislabeled){
+          noise -= noise * ADAPTIVE_NOISE_PHI / 2;
+          adapted = TRUE;
+        }else if(number_iterations - noise_iteration > params->adaptive_noise * aaf->number_of_arguments){
+          noise += (1 - noise) * ADAPTIVE_NOISE_PHI;
+          adapted = TRUE;
+        }
+        if(adapted){
+          noise_mislabeled = mislabeled->number_of_elements;
+          noise_iteration = number_iterations;
+          greedyprob = 1 - noise;
+          randsel = noise * randsel_share;
+          if(params->noise_log)
+            fprintf(stderr,"taas-haywood: noise %ld %f %d\n",number_iterations,noise,mislabeled->number_of_elements);
+        }
+      }
+      float prob = (SLS_GREEDY || SLS_RANDSEL) ? rng__double(rng) : 1;
+      if(SLS_GREEDY && prob < greedyprob && mislabeled_pqueue->length>0){
+        sel_arg = *binaryheap__extract_minimum(mislabeled_pqueue);
+        // skip tabu arguments and arguments whose configuration has not
+        // changed (at most TABU_MAX_SKIPPED) unless flipping them gives a new
+        // global minimum; they are put back afterwards
+        int skipped[TABU_MAX_SKIPPED];
+        int number_skipped = 0;
+        while((SLS_TABU || SLS_CC) && number_skipped < TABU_MAX_SKIPPED && mislabeled_pqueue->length > 0 &&
+            ((SLS_TABU && tabu_until[sel_arg] > number_iterations) || (SLS_CC && !bitset__get(cc_changed,sel_arg))) &&
+            mislabeled->number_of_elements + (SLS_WEIGHTED ? get_flipping_count(aaf,lab,sel_arg,SLS_DENSE,NULL) : mislabeled_pqueue->values[sel_arg]) >= best_mislabeled){
+          skipped[number_skipped++] = sel_arg;
+          sel_arg = *binaryheap__extract_minimum(mislabeled_pqueue);
+        }
+        for(int i = 0; i < number_skipped; i++)
+          binaryheap__insert(mislabeled_pqueue,&all_arguments[skipped[i]],mislabeled_pqueue->values[skipped[i]]);
+      }else if(SLS_RANDSEL && prob < greedyprob + randsel){
+        // select some argument uniformly at random
+        sel_arg = rng__bounded(rng,aaf->number_of_arguments);
+      }else if(SLS_PROBSAT){
+        // sample among a random mislabeled argument and its neighbours with
+        // probability decreasing (exponentially with base "probsat" or
+        // polynomially with exponent "probsat") in the flipping count
+        int arg = raset__random_element(mislabeled,rng);
+        int number_of_candidates = 0;
+        probsat_candidates[number_of_candidates++] = arg;
+        for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+          if(aaf->children_arr[k] != arg)
+            probsat_candidates[number_of_candidates++] = aaf->children_arr[k];
+        for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+          if(aaf->parents_arr[k] != arg)
+            probsat_candidates[number_of_candidates++] = aaf->parents_arr[k];
+        int min_score = INT_MAX;
+        for(int i = 0; i < number_of_candidates; i++){
+          int candidate = probsat_candidates[i];
+          if(!bitset__get(score_valid,candidate)){
+            scores[candidate] = get_flipping_count(aaf,lab,candidate,SLS_DENSE,weights);
+            bitset__set(score_valid,candidate);
+          }
+          if(scores[candidate] < min_score)
+            min_score = scores[candidate];
+        }
+        // relative to the best candidate (whose weight is 1)
+        double total = 0;
+        for(int i = 0; i < number_of_candidates; i++){
+          int difference = scores[probsat_candidates[i]] - min_score;
+          probsat_weights[i] = params->probsat_poly ? pow(1 + difference, -params->probsat) : pow(params->probsat, -difference);
+          total += probsat_weights[i];
+        }
+        double r = rng__double(rng) * total;
+        int i = 0;
+        while(i < number_of_candidates - 1 && (r -= probsat_weights[i]) >= 0)
+          i++;
+        sel_arg = probsat_candidates[i];
+      }else{
+        sel_arg = raset__random_element(mislabeled,rng);
+        // draw again (at most WEIGHT_MAX_DRAWS times) with probability 1 minus
+        // the weight of the argument relative to the maximal weight
+        for(int i = 0; SLS_WEIGHTED && i < WEIGHT_MAX_DRAWS && (int)rng__bounded(rng,max_weight) >= weights[sel_arg]; i++)
+          sel_arg = raset__random_element(mislabeled,rng);
+        // draw again (at most TABU_MAX_SKIPPED times) while the argument is
+        // tabu or its configuration has not changed and flipping it does not
+        // give a new global minimum
+        for(int i = 0; (SLS_TABU || SLS_CC) && i < TABU_MAX_SKIPPED &&
+            ((SLS_TABU && tabu_until[sel_arg] > number_iterations) || (SLS_CC && !bitset__get(cc_changed,sel_arg))) &&
+            mislabeled->number_of_elements + get_flipping_count(aaf,lab,sel_arg,SLS_DENSE,NULL) >= best_mislabeled; i++)
+          sel_arg = raset__random_element(mislabeled,rng);
+      }
+      // if the selected argument is a member of an odd cycle and there is no
+      // argument attacking that cycle labelled in, select such an attacker instead
+      // (only if odd cycles have been computed)
+      if(SLS_OCC && occ__contains(occ,sel_arg)){
+        struct RaSet* attackers = occ__get_attackers(occ,sel_arg);
+        // if there is at least one attacker already labelled in, everything is fine
+        int all_out = TRUE;
+        for(int i = 0; i < attackers->number_of_elements; i++)
+          if(bitset__get(lab->in, raset__get(attackers, i))){
+            all_out = FALSE;
+            break;
+          }
+        // select an attacker at random
+        if(all_out){
+          // if no argument attacks the odd cycle there cannot be a stable labeling
+          if(attackers->number_of_elements == 0)
+            break;
+          sel_arg = raset__random_element(attackers,rng);
+        }
+      }
+      // toggle label
+      if(taas__lab_get_label_twovalued(lab,sel_arg) == LAB_IN){
+        bitset__unset(lab->in,sel_arg);
+        // add the argument itself to toBeChecked
+        raset__add(toBeChecked,sel_arg);
+      }else{
+        // if the selected argument is self-attacking, select
+        // another attacker of that argument instead
+        if(bitset__get(aaf->loops,sel_arg)){
+          long number_of_attackers = 0;
+          for(long k = aaf->parents_idx[sel_arg]; k < aaf->parents_idx[sel_arg+1]; k++)
+            if(aaf->parents_arr[k] != sel_arg)
+              number_of_attackers++;
+          // if there is no other attacker there cannot be a stable extension
+          if(number_of_attackers == 0)
+            break;
+          // pick one of the other attackers uniformly at random
+          long r = rng__bounded(rng,number_of_attackers);
+          long k = aaf->parents_idx[sel_arg];
+          for(;; k++)
+            if(aaf->parents_arr[k] != sel_arg && r-- == 0)
+              break;
+          sel_arg = aaf->parents_arr[k];
+        }
+        // label it in
+        bitset__set(lab->in,sel_arg);
+        // add the argument itself to toBeChecked
+        raset__add(toBeChecked,sel_arg);
+        // if "enforceout" is true then all arguments in the neighbourhood are
+        // labeled out
+        if(SLS_ENFORCEOUT){
+          //while setting the neighbourhood to out,
+          //add the indirect neighbourhood to toBeChecked
+          for(long k = aaf->children_idx[sel_arg]; k < aaf->children_idx[sel_arg+1]; k++){
+            int child = aaf->children_arr[k];
+            bitset__unset(lab->in, child);
+            if(best != NULL)
+              best_labeling__log(best, child);
+            for(long k2 = aaf->children_idx[child]; k2 < aaf->children_idx[child+1]; k2++)
+              raset__add(toBeChecked,aaf->children_arr[k2]);
+            for(long k2 = aaf->parents_idx[child]; k2 < aaf->parents_idx[child+1]; k2++)
+              raset__add(toBeChecked,aaf->parents_arr[k2]);
+          }
+          for(long k = aaf->parents_idx[sel_arg]; k < aaf->parents_idx[sel_arg+1]; k++){
+            int parent = aaf->parents_arr[k];
+            bitset__unset(lab->in, parent);
+            if(best != NULL)
+              best_labeling__log(best, parent);
+            for(long k2 = aaf->children_idx[parent]; k2 < aaf->children_idx[parent+1]; k2++)
+              raset__add(toBeChecked,aaf->children_arr[k2]);
+            for(long k2 = aaf->parents_idx[parent]; k2 < aaf->parents_idx[parent+1]; k2++)
+              raset__add(toBeChecked,aaf->parents_arr[k2]);
+          }
+        }
+      }
+      // the flipped argument is tabu for the next "tabu" iterations (plus a
+      // random number of iterations up to the number of mislabeled arguments
+      // if "tabuadaptive" is set)
+      if(SLS_TABU)
+        tabu_until[sel_arg] = number_iterations + params->tabu + (params->tabu_adaptive ? rng__bounded(rng,mislabeled->number_of_elements + 1) : 0);
+      flipped = sel_arg;
+      if(best != NULL)
+        best_labeling__log(best, sel_arg);
+      //add the direct neighbourhood to toBeChecked
+      for(long k = aaf->children_idx[sel_arg]; k < aaf->children_idx[sel_arg+1]; k++)
+        raset__add(toBeChecked,aaf->children_arr[k]);
+      for(long k = aaf->parents_idx[sel_arg]; k < aaf->parents_idx[sel_arg+1]; k++)
+        raset__add(toBeChecked,aaf->parents_arr[k]);
+    }
+    // check direct/indirect neighbourhood of selected argument for changes
+    for(int i = 0 ; i < toBeChecked->number_of_elements; i++){
+      int elem = raset__get(toBeChecked,i);
+      // the configuration of the neighbours of a flipped argument changes
+      if(SLS_CC)
+        bitset__set(cc_changed,elem);
+      if(SLS_PROBSAT){
+        bitset__unset(score_valid,elem);
+        for(long k = aaf->children_idx[elem]; k < aaf->children_idx[elem+1]; k++)
+          bitset__unset(score_valid,aaf->children_arr[k]);
+        for(long k = aaf->parents_idx[elem]; k < aaf->parents_idx[elem+1]; k++)
+          bitset__unset(score_valid,aaf->parents_arr[k]);
+      }
+      int labeled_correctly = taas__labeled_correctly_twovalued(aaf,lab,elem,SLS_DENSE);
+      if(!labeled_correctly)
+        raset__add(mislabeled,elem);
+      else
+        raset__remove(mislabeled,elem);
+      // update greedy structures
+      if(SLS_GREEDY && (!labeled_correctly || SLS_GREEDYINCALL))
+        binaryheap__update(mislabeled_pqueue,&all_arguments[elem],get_flipping_count(aaf,lab,elem,SLS_DENSE,weights));
+      else if(SLS_GREEDY && labeled_correctly && !SLS_GREEDYINCALL && binaryheap__contains(mislabeled_pqueue,&all_arguments[elem])){
+        binaryheap__remove(mislabeled_pqueue,&all_arguments[elem]);
+      }
+    }
+    // the configuration of the flipped argument itself is the one it has
+    // been flipped in
+    if(SLS_CC && flipped != -1)
+      bitset__unset(cc_changed,flipped);
+  }while(mislabeled->number_of_elements > 0);
+  //------------------
+  // MAIN LOOP - END
+  //------------------
+  int found = mislabeled->number_of_elements == 0;
+  // free some variables
+  if(mislabeled_pqueue != NULL)
+    binaryheap__destroy(mislabeled_pqueue);
+  arena__destroy(arena);
+  return found;
+}
+
+#undef SLS_NAME
+#undef SLS_DENSE
+#undef SLS_LOCMINRES
+#undef SLS_GREEDY
+#undef SLS_GREEDYINCALL
+#undef SLS_RANDSEL
+#undef SLS_ENFORCEOUT
+#undef SLS_OCC
+#undef SLS_INITOUT
+#undef SLS_LNS
+#undef SLS_TABU
+#undef SLS_NOISE
+#undef SLS_WEIGHTED
+#undef SLS_CC
+#undef SLS_PROBSAT
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
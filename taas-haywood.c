@@ -9,15 +9,24 @@
  Copyright   : GPL3
  Description : The taas-haywood solver for abstract argumentation.
                Additional (optional) parameters
-               "-rseed X" explicitly set the random seed to X (default: time(NULL))
-               "-maxit X" the maximal number of iterations X, afterwards "NO" is returned
-                (which may not be the correct answer);
+               "-rseed X" explicitly set the random seed to X (default: time(NULL)); runs with the same seed
+                and parameters are reproducible
+               "-maxit X" the maximal number of iterations X of the local search, afterwards the complete
+                search is run (or "NO" is returned if "-complete" is 0, which may not be the correct answer);
                 if both "-maxit" and if "-maxitdyn" are provided, the minimum is taken
                 (default: number of arguments * 1000)
-               "-maxitdyn X" the maximal number of iterations X as a factor of the number
-                of arguments, afterwards "NO" is returned (which may not be the correct answer);
+               "-maxitdyn X" the maximal number of iterations X of the local search as a factor of the number
+                of arguments, afterwards the complete search is run (or "NO" is returned if "-complete" is 0,
+                which may not be the correct answer);
                 if both "-maxit" and if "-maxitdyn" are provided, the minimum is taken
                 (default: number of arguments * 1000)
+               "-complete X" if value is 1 then, once the local search has reached the maximal number of
+                iterations, a complete CDCL search (with the last labeling of the local search as the initial
+                phases) decides the existence of a stable extension, so every "NO" is exact (default: 1)
+               "-tdwidth X" parts of the residual AAF for which a tree decomposition (min-degree elimination
+                ordering of the undirected attack graph) of width at most X is found are decided exactly by
+                dynamic programming over it instead of the local search; 0 disables this
+                (default: TREEDECOMP_MAX_WIDTH)
                "-restart X" the number of iterations X (as an absolute number) after which
                 the search is restarted or -1 if restarts are disabled;
                 if both "-restart" and "-restartdyn" are provided, the minimum is taken (default: -1)
@@ -51,6 +60,60 @@
                 at each iteration N we do a restart with probability  P(N)=1-\frac{1}{\log_b (N-N_min+X)} where
                 N_min is the iteration number with the first global minimum so far. Option is disabled if X=0,
                 should be set to a value in (1,2]   (default: '0')
+               "-lns X" if X > 0 then, whenever the number of mislabeled arguments has not decreased for X
+                iterations (since the last restart or repair) and there are at most LNS_MAX_MISLABELED of
+                them, the region around them (see "-lnsradius") is relabeled by a complete search bounded by
+                LNS_MAX_CONFLICTS conflicts, such that the region and its neighbours are labeled correctly,
+                while all other arguments keep their labels; the walk continues from the repaired
+                labeling; X is doubled after every failed repair (and reset after a successful one), and a
+                repair is not tried again for the same mislabeled arguments or region (default: 0)
+               "-lnsradius X" the radius X (in attacks in either direction) of the region around the
+                mislabeled arguments repaired by "-lns"; regions are cut at LNS_MAX_REGION arguments and at
+                the LNS_REGION_DIVISOR-th part of all arguments (default: LNS_RADIUS)
+               "-tabu X" if X > 0 then an argument that has been flipped must not be flipped again for the
+                next X iterations unless this gives a new global minimum of the number of mislabeled arguments;
+                random and greedy choices draw again or take the next best argument instead (at most
+                TABU_MAX_SKIPPED times) (default: 0)
+               "-tabuadaptive X" if value is 1 then the tenure of "-tabu" is increased by a random number of
+                iterations up to the number of mislabeled arguments at the time of the flip (default: 0)
+               "-adaptivenoise X" if X > 0 then the noise, i.e., the probability of a move that is not greedy
+                (initially 1 minus "-greedyprob"), is adapted during the search: it is raised by
+                ADAPTIVE_NOISE_PHI times (1 - noise) if the number of mislabeled arguments has not decreased
+                for X times the number of arguments iterations since the last adaptation, and lowered by
+                ADAPTIVE_NOISE_PHI/2 times the noise whenever it decreases; arbitrary random moves (see
+                "-randsel") keep their share of the noise (default: 0)
+               "-noiselog X" if value is 1 then every adaptation of "-adaptivenoise" is logged to stderr as
+                "taas-haywood: noise <iteration> <noise> <number of mislabeled arguments>" (default: 0)
+               "-weighted X" if X > 0 then every argument has a weight (initially 1) that is increased by 1
+                whenever the argument is mislabeled in a local minimum, i.e., when no greedy move decreases
+                the weighted number of mislabeled arguments; after every X-th increase all weights above 1
+                are decreased by 1; greedy moves minimise the weighted flipping count and random moves prefer
+                arguments of large weight (default: 0)
+               "-cc X" if value is 1 then configuration checking is used: an argument may only be flipped
+                again after some argument in its neighbourhood has been flipped since its own last flip, unless
+                this gives a new global minimum of the number of mislabeled arguments; random and greedy
+                choices draw again or take the next best argument instead (at most TABU_MAX_SKIPPED times)
+                (default: 0)
+               "-probsat X" if X > 1 then a random move (instead of flipping a random mislabeled argument)
+                draws a random mislabeled argument and flips it or one of its neighbours, each with probability
+                proportional to X^(-d) where d is its flipping count (see "-greedyprob") minus the minimal one
+                among them; values X <= 1 (which would not prefer better moves) disable this (default: 0)
+               "-probsatpoly X" if value is 1 then the probabilities of "-probsat" are proportional to
+                (1+d)^(-X) instead; then any X > 0 enables "-probsat" (default: 0)
+               "-hugepages X" if value is 1 then large arrays (adjacency arrays and matrices, labelings,
+                sets) are backed by huge pages if possible (MAP_HUGETLB or madvise(MADV_HUGEPAGE)) (default: 1)
+               "-numa X" placement of large arrays on NUMA machines: "none" (first touch) or "interleave"
+                (pages are interleaved over all nodes) (default: "none")
+               "-dense X" if value is 1 then the AAF is additionally represented by adjacency bit matrices
+                and correctness of labels is checked by word-wide AND/popcount of a matrix row with the set of
+                "in" arguments; if value is 0 adjacency lists are used only; by default the bit matrices are
+                used if the attack density is at least DENSE_MIN_DENSITY and they need at most
+                DENSE_MAX_BYTES bytes (default: automatic)
+               "-threads X" the number of threads X used for searching the weakly connected components of
+                the AAF in parallel (if there are several) and otherwise for verifying whole labelings (at
+                restarts and before printing an extension); only AAFs with at least
+                VERIFY_MIN_ARGUMENTS_PER_THREAD arguments per thread use more than one thread for
+                verifying (default: 1)
 ============================================================================
 */
 #define COMPUTATION_FINISHED 0
@@ -64,6 +127,18 @@
 
 #define TRUE 1
 #define FALSE 0
+
+// minimal attack density for automatically using adjacency bit matrices
+#define DENSE_MIN_DENSITY 0.03
+// maximal memory (in bytes) for automatically using adjacency bit matrices
+#define DENSE_MAX_BYTES 536870912.0
+// maximal number of tabu arguments (or arguments whose configuration has not changed, see "-cc")
+// skipped when selecting an argument to flip
+#define TABU_MAX_SKIPPED 8
+// the rate of the adaptation of the noise (see "-adaptivenoise")
+#define ADAPTIVE_NOISE_PHI 0.2
+// maximal number of times a random move draws again an argument of small weight (see "-weighted")
+#define WEIGHT_MAX_DRAWS 4
 /* ============================================================================================================== */
 /* ============================================================================================================== */
 #include <string.h>
@@ -72,48 +147,80 @@
 #include <ctype.h>
 #include <math.h>
 #include <time.h>
+#include <limits.h>
+#include <stdint.h>
 #include <sys/types.h>
+#include <pthread.h>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
 
+#include "util/memory.c"
+#include "util/arena.c"
+#include "util/random.c"
 #include "util/bitset.c"
+#include "util/bitmatrix.c"
 #include "util/linkedlist.c"
 #include "util/miscutil.c"
 #include "util/hashtable.c"
 #include "util/binaryheap.c"
 #include "util/raset.c"
+#include "util/cdcl.c"
 
 #include "taas/taas_aaf.c"
 #include "taas/taas_inout.c"
 #include "taas/taas_labeling.c"
 #include "taas/taas_basics.c"
+#include "taas/taas_verify.c"
+#include "taas/taas_propagation.c"
+#include "taas/taas_symmetric.c"
+#include "taas/taas_twins.c"
+#include "taas/taas_exact.c"
+#include "taas/taas_complete.c"
+#include "taas/taas_treedecomp.c"
+#include "taas/taas_lns.c"
 
 #include "util/graph.c"
+#include "taas/taas_oddcyclefree.c"
+#include "taas/taas_refutation.c"
 /* ============================================================================================================== */
 /* ============================================================================================================== */
 
 // Initialise random number generator
-void init_srand(struct TaskSpecification *task){
+void init_rng(struct TaskSpecification *task, struct Rng* rng){
   char* rseed = taas__task_get_value(task,"-rseed");
   if(rseed != NULL)
-    srand(atoi(rseed));
-  else{
-    int t = time(NULL);
-    //printf("%i\n", t);
-    srand(time(NULL));
-  }
+    rng__seed(rng,strtoull(rseed,NULL,10));
+  else
+    rng__seed(rng,time(NULL));
+}
+
+// parses a non-negative count parameter and multiplies it with the given factor;
+// the result saturates at LONG_MAX instead of overflowing
+long __parse_count(char* param, long factor){
+  long long value = strtoll(param,NULL,10);
+  if(value <= 0)
+    return value;
+  if(factor > 0 && value > LONG_MAX / factor)
+    return LONG_MAX;
+  return (long)(value * factor);
 }
 
 //check restart setting
-int init_restart(struct TaskSpecification *task, struct AAF* aaf){
+long init_restart(struct TaskSpecification *task, struct AAF* aaf){
   char* restart_param = taas__task_get_value(task,"-restart");
   char* restartdyn_param = taas__task_get_value(task,"-restartdyn");
-  int restart;
-  if(restart_param != NULL && restartdyn_param != NULL){
-    restart = (atoi(restartdyn_param) * aaf->number_of_arguments) > atoi(restart_param) ? atoi(restartdyn_param) * aaf->number_of_arguments : atoi(restart_param);
-  }else if(restartdyn_param != NULL)
-    restart = atoi(restartdyn_param) * aaf->number_of_arguments;
-  else if(restart_param != NULL)
-    restart = atoi(restart_param);
-  else restart = -1;
+  long restart = -1;
+  if(restartdyn_param != NULL && __parse_count(restartdyn_param,1) > 0)
+    restart = __parse_count(restartdyn_param,aaf->number_of_arguments);
+  if(restart_param != NULL && __parse_count(restart_param,1) > 0)
+    if(restart == -1 || __parse_count(restart_param,1) < restart)
+      restart = __parse_count(restart_param,1);
   return restart;
 }
 
@@ -123,12 +230,14 @@ long init_max_iterations(struct TaskSpecification *task, struct AAF* aaf){
   char* maxit = taas__task_get_value(task,"-maxit");
   long max_iterations;
   if(maxitdyn != NULL && maxit != NULL){
-    max_iterations = (atoi(maxitdyn) * aaf->number_of_arguments) > atoi(maxit) ? atoi(maxitdyn) * aaf->number_of_arguments : atoi(maxit);
+    max_iterations = __parse_count(maxitdyn,aaf->number_of_arguments);
+    if(__parse_count(maxit,1) < max_iterations)
+      max_iterations = __parse_count(maxit,1);
   }else if(maxitdyn != NULL)
-    max_iterations = atoi(maxitdyn) * aaf->number_of_arguments;
+    max_iterations = __parse_count(maxitdyn,aaf->number_of_arguments);
   else if(maxit != NULL)
-    max_iterations = atoi(maxit);
-  else max_iterations = 1000 * aaf->number_of_arguments;
+    max_iterations = __parse_count(maxit,1);
+  else max_iterations = 1000L * aaf->number_of_arguments;
   return max_iterations;
 }
 
@@ -187,280 +296,689 @@ float init_locminres(struct TaskSpecification *task){
   return 0;
 }
 
+//check lns setting
+long init_lns(struct TaskSpecification *task){
+  char* lns = taas__task_get_value(task,"-lns");
+  if(lns != NULL)
+    return __parse_count(lns,1);
+  return 0;
+}
+
+//check lnsradius setting
+int init_lns_radius(struct TaskSpecification *task){
+  char* lnsradius = taas__task_get_value(task,"-lnsradius");
+  if(lnsradius != NULL)
+    return atoi(lnsradius);
+  return LNS_RADIUS;
+}
+
+//check tabu setting
+long init_tabu(struct TaskSpecification *task){
+  char* tabu = taas__task_get_value(task,"-tabu");
+  if(tabu != NULL)
+    return __parse_count(tabu,1);
+  return 0;
+}
+
+//check tabuadaptive setting
+int init_tabu_adaptive(struct TaskSpecification *task){
+  char* tabu_adaptive = taas__task_get_value(task,"-tabuadaptive");
+  if(tabu_adaptive != NULL)
+    return atoi(tabu_adaptive);
+  return FALSE;
+}
+
+//check adaptivenoise setting
+float init_adaptive_noise(struct TaskSpecification *task){
+  char* adaptive_noise = taas__task_get_value(task,"-adaptivenoise");
+  if(adaptive_noise != NULL)
+    return atof(adaptive_noise);
+  return 0;
+}
+
+//check noiselog setting
+int init_noise_log(struct TaskSpecification *task){
+  char* noise_log = taas__task_get_value(task,"-noiselog");
+  if(noise_log != NULL)
+    return atoi(noise_log);
+  return FALSE;
+}
+
+//check weighted setting
+long init_weighted(struct TaskSpecification *task){
+  char* weighted = taas__task_get_value(task,"-weighted");
+  if(weighted != NULL)
+    return __parse_count(weighted,1);
+  return 0;
+}
+
+//check cc setting
+int init_cc(struct TaskSpecification *task){
+  char* cc = taas__task_get_value(task,"-cc");
+  if(cc != NULL)
+    return atoi(cc);
+  return FALSE;
+}
+
+//check probsatpoly setting
+int init_probsat_poly(struct TaskSpecification *task){
+  char* probsat_poly = taas__task_get_value(task,"-probsatpoly");
+  if(probsat_poly != NULL)
+    return atoi(probsat_poly);
+  return FALSE;
+}
+
+//check probsat setting (the base of the exponential must be larger than 1)
+float init_probsat(struct TaskSpecification *task){
+  char* probsat = taas__task_get_value(task,"-probsat");
+  if(probsat != NULL && atof(probsat) > (init_probsat_poly(task) ? 0 : 1))
+    return atof(probsat);
+  return 0;
+}
+
+//check dense setting
+int init_dense(struct TaskSpecification *task, struct AAF* aaf){
+  char* dense = taas__task_get_value(task,"-dense");
+  if(dense != NULL)
+    return atoi(dense);
+  double bytes = 2.0 * aaf->number_of_arguments * ((double)aaf->number_of_arguments / 8);
+  return taas__aaf_density(aaf) >= DENSE_MIN_DENSITY && bytes <= DENSE_MAX_BYTES;
+}
+
+//check complete setting
+int init_complete(struct TaskSpecification *task){
+  char* complete = taas__task_get_value(task,"-complete");
+  if(complete != NULL)
+    return atoi(complete);
+  return TRUE;
+}
+
+//check tree decomposition width setting
+int init_tdwidth(struct TaskSpecification *task){
+  char* tdwidth = taas__task_get_value(task,"-tdwidth");
+  if(tdwidth != NULL)
+    return atoi(tdwidth);
+  return TREEDECOMP_MAX_WIDTH;
+}
+
+//check threads setting
+int init_threads(struct TaskSpecification *task){
+  char* threads = taas__task_get_value(task,"-threads");
+  if(threads != NULL && atoi(threads) > 0)
+    return atoi(threads);
+  return 1;
+}
+
 // computes the flipping count of the given argument, i.e. the number of correctly labeled
 // arguments in the neighbourhood of the argument MINUS the number of correctly labeled
-// arguments in the neighbourhood of the argument if the argument would be flipped.
-int get_flipping_count(struct AAF* aaf,struct Labeling* lab, int arg){
+// arguments in the neighbourhood of the argument if the argument would be flipped
+// (lab must be two-valued; "dense" says whether to use the adjacency bit matrices);
+// if "weights" is not NULL, each argument is counted with its weight.
+static inline int get_flipping_count(struct AAF* aaf,struct Labeling* lab, int arg, int dense, int* weights){
   int flipping_count = 0;
   int new_label = bitset__get(lab->in,arg)? LAB_OUT : LAB_IN;
-  flipping_count += taas__labeled_correctly(aaf,lab,arg) ? 1 : 0;
-  flipping_count += taas__labeled_correctly_under_assumption(aaf,lab,arg,arg,new_label) ? -1 : 0;
-  for(struct LinkedListNode* node = aaf->children[arg].root; node != NULL; node = node->next){
-    flipping_count += taas__labeled_correctly(aaf,lab,*(int*)node->data) ? 1 : 0;
-    flipping_count += taas__labeled_correctly_under_assumption(aaf,lab,*(int*)node->data,arg,new_label) ? -1 : 0;
+  int weight = weights != NULL ? weights[arg] : 1;
+  flipping_count += taas__labeled_correctly_twovalued(aaf,lab,arg,dense) ? weight : 0;
+  flipping_count += taas__labeled_correctly_under_assumption_twovalued(aaf,lab,arg,arg,new_label,dense) ? -weight : 0;
+  for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++){
+    weight = weights != NULL ? weights[aaf->children_arr[k]] : 1;
+    flipping_count += taas__labeled_correctly_twovalued(aaf,lab,aaf->children_arr[k],dense) ? weight : 0;
+    flipping_count += taas__labeled_correctly_under_assumption_twovalued(aaf,lab,aaf->children_arr[k],arg,new_label,dense) ? -weight : 0;
   }
-  for(struct LinkedListNode* node = aaf->parents[arg].root; node != NULL; node = node->next){
-    flipping_count += taas__labeled_correctly(aaf,lab,*(int*)node->data) ? 1 : 0;
-    flipping_count += taas__labeled_correctly_under_assumption(aaf,lab,*(int*)node->data,arg,new_label) ? -1 : 0;
+  for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+    weight = weights != NULL ? weights[aaf->parents_arr[k]] : 1;
+    flipping_count += taas__labeled_correctly_twovalued(aaf,lab,aaf->parents_arr[k],dense) ? weight : 0;
+    flipping_count += taas__labeled_correctly_under_assumption_twovalued(aaf,lab,aaf->parents_arr[k],arg,new_label,dense) ? -weight : 0;
   }
   return flipping_count;
 }
 
+// updates the flipping count (in the heap, if contained) of "arg_other" after the weight of
+// its neighbour (or itself) "arg" has changed by "change"; "correct" says whether "arg" is
+// labeled correctly; the cached score of "arg_other" (if score_valid is not NULL) is invalidated
+static inline void __update_weighted_flipping_count(struct AAF* aaf, struct Labeling* lab, int arg, int correct, int arg_other, int change,
+    int dense, struct BinaryHeap* heap, int* all_arguments, struct BitSet* score_valid){
+  if(score_valid != NULL)
+    bitset__unset(score_valid,arg_other);
+  if(!binaryheap__contains(heap,&all_arguments[arg_other]))
+    return;
+  int new_label = bitset__get(lab->in,arg_other)? LAB_OUT : LAB_IN;
+  int delta = correct - (taas__labeled_correctly_under_assumption_twovalued(aaf,lab,arg,arg_other,new_label,dense) ? 1 : 0);
+  if(delta != 0)
+    binaryheap__update(heap,&all_arguments[arg_other],binaryheap__value_of(heap,&all_arguments[arg_other]) + change * delta);
+}
+
+// changes the weight of the given argument by "change" and updates the flipping counts
+// (see get_flipping_count()) in the heap of the arguments depending on it, i.e. of the
+// argument itself and its neighbours, without recomputing them
+static inline void change_weight(struct AAF* aaf, struct Labeling* lab, int arg, int change, int dense, int* weights,
+    struct BinaryHeap* heap, int* all_arguments, struct BitSet* score_valid){
+  weights[arg] += change;
+  int correct = taas__labeled_correctly_twovalued(aaf,lab,arg,dense) ? 1 : 0;
+  __update_weighted_flipping_count(aaf,lab,arg,correct,arg,change,dense,heap,all_arguments,score_valid);
+  for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+    __update_weighted_flipping_count(aaf,lab,arg,correct,aaf->children_arr[k],change,dense,heap,all_arguments,score_valid);
+  for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+    __update_weighted_flipping_count(aaf,lab,arg,correct,aaf->parents_arr[k],change,dense,heap,all_arguments,score_valid);
+}
+
+// the parameters of the local search
+struct SearchParameters{
+  long restart;
+  long max_iterations;
+  float greedyprob;
+  int greedyincall;
+  int init_out;
+  int enforce_out;
+  float randsel;
+  float locminres;
+  long lns;
+  int lnsradius;
+  long tabu;
+  int tabu_adaptive;
+  float adaptive_noise;
+  int noise_log;
+  long weighted;
+  int cc;
+  float probsat;
+  int probsat_poly;
+  int threads;
+  // if not NULL, the search is aborted as soon as *stop is TRUE
+  int* stop;
+  // if not NULL, receives the labeling with the fewest mislabeled arguments
+  // of the search (initialised with the number of arguments)
+  struct BitSet* best;
+};
+
+// the labeling with the fewest mislabeled arguments of a search so far; the
+// arguments whose labels have changed since it has been stored are logged,
+// and once there are more of them than words of the labeling it is stored
+// completely next time, so storing it takes amortised constant time per flip
+struct BestLabeling{
+  struct BitSet* in;
+  int mislabeled;
+  int* log;
+  int log_size;
+  int log_capacity;
+  int full;
+};
+
+// returns an empty best labeling to be stored in "in"; it is released with the arena
+struct BestLabeling* best_labeling__init(struct BitSet* in, struct Arena* arena){
+  struct BestLabeling* best = arena__alloc(arena, sizeof(struct BestLabeling));
+  best->in = in;
+  best->mislabeled = INT_MAX;
+  best->log_capacity = in->num_elements + 16;
+  best->log = arena__alloc(arena, best->log_capacity * sizeof(int));
+  best->log_size = 0;
+  best->full = TRUE;
+  return best;
+}
+
+// notes that the label of the given argument has changed
+static inline void best_labeling__log(struct BestLabeling* best, int arg){
+  if(best->full)
+    return;
+  if(best->log_size == best->log_capacity)
+    best->full = TRUE;
+  else best->log[best->log_size++] = arg;
+}
+
+// stores the given labeling if it has fewer mislabeled arguments
+static inline void best_labeling__update(struct BestLabeling* best, struct BitSet* in, int mislabeled){
+  if(mislabeled >= best->mislabeled)
+    return;
+  best->mislabeled = mislabeled;
+  if(best->full)
+    memcpy(best->in->data, in->data, in->num_elements * sizeof(uint64_t));
+  else for(int i = 0; i < best->log_size; i++){
+    if(bitset__get(in,best->log[i]))
+      bitset__set(best->in,best->log[i]);
+    else bitset__unset(best->in,best->log[i]);
+  }
+  best->log_size = 0;
+  best->full = FALSE;
+}
+
+/* ============================================================================================================== */
+/* The main loop of the local search is instantiated several times from taas-haywood-loop.c:                      */
+/* specialised variants for the common option combinations (where the options are compile-time constants)        */
+/* and a generic variant that tests all options at runtime.                                                       */
+/* ============================================================================================================== */
+
+// plain random walk
+#define SLS_NAME sls__random_walk
+#define SLS_DENSE 0
+#define SLS_LOCMINRES 0
+#define SLS_GREEDY 0
+#define SLS_GREEDYINCALL 0
+#define SLS_RANDSEL 0
+#define SLS_ENFORCEOUT 0
+#define SLS_OCC 0
+#define SLS_INITOUT 0
+#define SLS_LNS 0
+#define SLS_TABU 0
+#define SLS_NOISE 0
+#define SLS_WEIGHTED 0
+#define SLS_CC 0
+#define SLS_PROBSAT 0
+#include "taas-haywood-loop.c"
+
+// plain random walk on adjacency bit matrices
+#define SLS_NAME sls__random_walk_dense
+#define SLS_DENSE 1
+#define SLS_LOCMINRES 0
+#define SLS_GREEDY 0
+#define SLS_GREEDYINCALL 0
+#define SLS_RANDSEL 0
+#define SLS_ENFORCEOUT 0
+#define SLS_OCC 0
+#define SLS_INITOUT 0
+#define SLS_LNS 0
+#define SLS_TABU 0
+#define SLS_NOISE 0
+#define SLS_WEIGHTED 0
+#define SLS_CC 0
+#define SLS_PROBSAT 0
+#include "taas-haywood-loop.c"
+
+// random walk with greedy moves
+#define SLS_NAME sls__greedy_walk
+#define SLS_DENSE 0
+#define SLS_LOCMINRES 0
+#define SLS_GREEDY 1
+#define SLS_GREEDYINCALL 0
+#define SLS_RANDSEL 0
+#define SLS_ENFORCEOUT 0
+#define SLS_OCC 0
+#define SLS_INITOUT 0
+#define SLS_LNS 0
+#define SLS_TABU 0
+#define SLS_NOISE 0
+#define SLS_WEIGHTED 0
+#define SLS_CC 0
+#define SLS_PROBSAT 0
+#include "taas-haywood-loop.c"
+
+// random walk with greedy moves on adjacency bit matrices
+#define SLS_NAME sls__greedy_walk_dense
+#define SLS_DENSE 1
+#define SLS_LOCMINRES 0
+#define SLS_GREEDY 1
+#define SLS_GREEDYINCALL 0
+#define SLS_RANDSEL 0
+#define SLS_ENFORCEOUT 0
+#define SLS_OCC 0
+#define SLS_INITOUT 0
+#define SLS_LNS 0
+#define SLS_TABU 0
+#define SLS_NOISE 0
+#define SLS_WEIGHTED 0
+#define SLS_CC 0
+#define SLS_PROBSAT 0
+#include "taas-haywood-loop.c"
+
+// generic variant
+#define SLS_NAME sls__generic
+#define SLS_DENSE (aaf->dense)
+#define SLS_LOCMINRES (params->locminres > 0)
+#define SLS_GREEDY (params->greedyprob > 0 || params->adaptive_noise > 0 || params->weighted > 0)
+#define SLS_GREEDYINCALL (params->greedyincall)
+#define SLS_RANDSEL (params->randsel > 0)
+#define SLS_ENFORCEOUT (params->enforce_out)
+#define SLS_OCC (occ != NULL)
+#define SLS_INITOUT (params->init_out)
+#define SLS_LNS (params->lns > 0)
+#define SLS_TABU (params->tabu > 0)
+#define SLS_NOISE (params->adaptive_noise > 0)
+#define SLS_WEIGHTED (params->weighted > 0)
+#define SLS_CC (params->cc)
+#define SLS_PROBSAT (params->probsat > 0)
+#include "taas-haywood-loop.c"
+
+// selects the variant of the main loop for the given AAF and parameters
+int (*sls__select(struct AAF* aaf, struct SearchParameters* params, struct OddCycleCollection* occ))
+    (struct AAF*, struct SearchParameters*, struct OddCycleCollection*, struct Rng*, struct Labeling*){
+  if(params->locminres > 0 || params->greedyincall || params->randsel > 0 || params->enforce_out || occ != NULL || params->init_out ||
+      params->lns > 0 || params->tabu > 0 || params->adaptive_noise > 0 || params->weighted > 0 || params->cc ||
+      params->probsat > 0)
+    return sls__generic;
+  if(params->greedyprob > 0)
+    return aaf->dense ? sls__greedy_walk_dense : sls__greedy_walk;
+  return aaf->dense ? sls__random_walk_dense : sls__random_walk;
+}
+
 /**
- * Solve SE-ST
+ * Searches for a stable extension of the given AAF (the part of the residual
+ * AAF to be searched) and stores it in "in" (initialised with the number of
+ * arguments); returns TRUE iff one has been found. The search is aborted
+ * as soon as *stop is TRUE (if stop is not NULL).
  */
-void solve(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
-  // in order to have pointers to the arguments
-  int* all_arguments = malloc(aaf->number_of_arguments * sizeof(int));
-  for(int i = 0; i < aaf->number_of_arguments; i++)
-    all_arguments[i] = i;
-  // do some intialising
-  init_srand(task);
+int search_part(struct TaskSpecification *task, struct AAF* aaf, int threads, int* stop, struct Rng* rng, struct BitSet* in){
+  // small parts are decided exactly
+  if(aaf->number_of_arguments <= EXACT_MAX_ARGUMENTS){
+    int found = taas__exact_stable(aaf,in);
+    if(!found)
+      fprintf(stderr,"taas-haywood: no stable extension (exhaustive search)\n");
+    return found;
+  }
+  // so are parts of small treewidth
+  int tdwidth = init_tdwidth(task);
+  if(tdwidth > 0){
+    struct TreeDecomposition* td = taas__treedecomp(aaf,tdwidth);
+    if(td != NULL){
+      int found = taas__treedecomp_stable(aaf,td,in);
+      taas__treedecomp_destroy(td);
+      if(!found)
+        fprintf(stderr,"taas-haywood: no stable extension (tree decomposition)\n");
+      return found;
+    }
+  }
   //read some parameters
-  int restart = init_restart(task,aaf);
-  long max_iterations = init_max_iterations(task,aaf);
-  float greedyprob = init_greedy_prob(task);
-  int greedyincall = init_greedy_include_all(task);
-  int init_out = init_init_out(task);
-  int enforce_out = init_enforce_out(task);
+  struct SearchParameters params;
+  params.restart = init_restart(task,aaf);
+  params.max_iterations = init_max_iterations(task,aaf);
+  params.greedyprob = init_greedy_prob(task);
+  params.greedyincall = init_greedy_include_all(task);
+  params.init_out = init_init_out(task);
+  params.enforce_out = init_enforce_out(task);
+  params.randsel = init_randsel(task);
+  params.locminres = init_locminres(task);
+  params.lns = init_lns(task);
+  params.lnsradius = init_lns_radius(task);
+  params.tabu = init_tabu(task);
+  params.tabu_adaptive = init_tabu_adaptive(task);
+  params.adaptive_noise = init_adaptive_noise(task);
+  params.noise_log = init_noise_log(task);
+  params.weighted = init_weighted(task);
+  params.cc = init_cc(task);
+  params.probsat = init_probsat(task);
+  params.probsat_poly = init_probsat_poly(task);
+  params.threads = threads;
+  params.stop = stop;
+  // the complete search starts from the best labeling of the local search
+  int complete = init_complete(task);
+  params.best = NULL;
+  if(complete){
+    params.best = malloc(sizeof(struct BitSet));
+    bitset__init(params.best,aaf->number_of_arguments);
+    bitset__unsetAll(params.best);
+  }
   int escapeoddcycles = init_escapeoddcycles(task);
-  float randsel= init_randsel(task);
-  float locminres = init_locminres(task);
-  float log_b;
-  if(locminres > 0)
-    log_b = 1/log(locminres);
+  if(init_dense(task,aaf))
+    taas__aaf_init_dense(aaf);
+  // Initialise labeling
+  struct Labeling lab;
+  lab.in = in;
+  lab.out = NULL;
+  lab.twoValued = TRUE;
+  // on symmetric AAFs a stable extension can usually be constructed directly
+  int found = aaf->symmetric && taas__symmetric_stable(aaf,lab.in);
   // check for odd cycle usage
   struct OddCycleCollection* occ = NULL;
-  if(escapeoddcycles){
+  int unattacked_odd_cycle = FALSE;
+  if(!found && escapeoddcycles){
     occ = occ__init(aaf);
     // if we found an unattacked odd cycle we can stop right away.
-    if(occ == NULL){
-      printf("NO\n");
-      return;
-    }
+    unattacked_odd_cycle = occ == NULL;
+    if(unattacked_odd_cycle)
+      fprintf(stderr,"taas-haywood: no stable extension (unattacked odd cycle)\n");
   }
-  // Initialise labeling
-  struct Labeling* lab = malloc(sizeof(struct Labeling));
-  taas__lab_init(lab,TRUE);
-  bitset__init(lab->in, aaf->number_of_arguments);
-  // The following data structure keeps track of the arguments that are not labeled correctly
-  struct RaSet* mislabeled = raset__init_empty(aaf->number_of_arguments);
-  // The following data structure collects arguments that have to be checked for their
-  // correct label after some change
-  struct RaSet* toBeChecked = raset__init_empty(aaf->number_of_arguments);
-  // the following  heap is used as a priority queue if greedy choices are enabled,
-  // i.e. it records for arguments their flipping number;
-  // for each argument currently correctly labeled +1 is added; for each
-  // argument labeled correctly after flipping -1 is added; thus, the smaller
-  // the number, the better the flip
-  struct BinaryHeap* mislabeled_pqueue = NULL;
-  // the following ints remember the global minimum of the number of mislabeled arguments (so far);
-  // only used if locminres > 0
-  int min_mislabeled;
-  int min_mislabeled_iteration;
-  // the following parameter keeps track of the number of iterations;
-  // the search is aborted once the maximal number of iterations is reached;
-  // then "NO" is returned (meaning no stable labeling "likely" exists)
-  int number_iterations = 0;
-  //------------------
-  // MAIN LOOP - BEGIN
-  //------------------
-  do{
-    // check if we need to restart because we think we are in a local minimum
-    int force_restart = FALSE;
-    if(locminres > 0){
-      // update current global minimum
-      if(mislabeled->number_of_elements < min_mislabeled){
-        min_mislabeled = mislabeled->number_of_elements;
-        min_mislabeled_iteration = number_iterations;
-      }else{
-        float prob = 1-log_b/log(number_iterations-min_mislabeled_iteration+locminres);
-        if((float)rand()/(float)RAND_MAX < prob)
-          force_restart = TRUE;
-      }
-    }
-    // whenever the restart parameter says so (or force_restart), randomise the labeling
-    if((number_iterations == 0) || (restart != -1 && (number_iterations % restart) == 0) || force_restart){
-      if(init_out){
-        // use the all-out labeling
-        bitset__unsetAll(lab->in);
-      }else taas__lab_randomize(lab);
-      // copy arguments in/out from grounded labeling, those are fixed
-      for(int i = 0; i < aaf->number_of_arguments; i++){
-        if(bitset__get(grounded->in,i))
-          bitset__set(lab->in,i);
-        else if(bitset__get(grounded->out,i))
-          bitset__unset(lab->in,i);
-      }
-      // reset mislabeled data structures
-      // NOTE: arguments in/out from the grounded labeling are always labeled correctly
-      raset__reset(mislabeled);
-      for(int i = 0; i < aaf->number_of_arguments; i++)
-        if(!bitset__get(grounded->in,i)&&!bitset__get(grounded->out,i))
-            if(!taas__labeled_correctly(aaf,lab,i))
-              raset__add(mislabeled,i);
-      // if we already have a stable labeling, break
-      if(mislabeled->number_of_elements == 0)
-        break;
-      // store minimum mislabeled number
-      if(locminres > 0){
-        min_mislabeled = mislabeled->number_of_elements;
-        min_mislabeled_iteration = 0;
-      }
-      // reset greedy choice datastructures, if needed
-      if(greedyprob>0){
-        // destroy the old heap
-        if(mislabeled_pqueue != NULL)
-          binaryheap__destroy(mislabeled_pqueue);
-        //create a new one
-        mislabeled_pqueue = malloc(sizeof(struct BinaryHeap));
-        binaryheap__init(mislabeled_pqueue, aaf->number_of_arguments);
-        // determine for each mislabeled argument (if greedyincall = false) or
-        // for each argument (if greedyincall = true) its "flipping number";
-        // for the latter also ignore arguments in/out the grounded labeling
-        if(greedyincall)
-          for(int i = 0; i < aaf->number_of_arguments; i++){
-            if(!bitset__get(grounded->in,i)&&!bitset__get(grounded->out,i))
-              binaryheap__insert(mislabeled_pqueue,&all_arguments[i],get_flipping_count(aaf,lab,i));
-          }
-        else
-          for(int i = 0; i < mislabeled->number_of_elements; i++){
-            int elem = raset__get(mislabeled,i);
-            binaryheap__insert(mislabeled_pqueue,&all_arguments[elem],get_flipping_count(aaf,lab,elem));
-          }
-      }
-    }
-    // check iteration count
-    number_iterations++;
-    if(number_iterations >= max_iterations)
+  // run the local search
+  if(!found && !unattacked_odd_cycle)
+    found = sls__select(aaf,&params,occ)(aaf,&params,occ,rng,&lab);
+  // if it fails, decide the part with the complete search
+  if(!found && !unattacked_odd_cycle && complete && (stop == NULL || !__atomic_load_n(stop,__ATOMIC_RELAXED))){
+    int result = taas__complete_stable(aaf,params.best,stop,lab.in);
+    found = result == CDCL_SAT;
+    if(result == CDCL_UNSAT)
+      fprintf(stderr,"taas-haywood: no stable extension (complete search)\n");
+  }
+  if(occ != NULL)
+    occ__destroy(occ);
+  if(params.best != NULL)
+    bitset__destroy(params.best);
+  return found;
+}
+
+// a weakly connected component to be searched by search_components()
+struct ComponentTask{
+  // the arguments of the component (ascending)
+  int* arguments;
+  int number_of_arguments;
+  // the random number generator for this component
+  struct Rng rng;
+  // the arguments (wrt. "arguments") in the stable extension found, if any
+  struct BitSet* in;
+};
+
+// the state shared by the threads of search_components()
+struct ComponentPool{
+  struct TaskSpecification* task;
+  struct AAF* aaf;
+  struct ComponentTask* tasks;
+  int number_of_tasks;
+  // the next task to be taken (atomic)
+  int next_task;
+  // set once some component has no stable extension (atomic)
+  int stop;
+};
+
+int __component_task__compare(const void* a, const void* b){
+  return ((const struct ComponentTask*)b)->number_of_arguments - ((const struct ComponentTask*)a)->number_of_arguments;
+}
+
+// takes tasks from the pool until there are none left or some search failed;
+// every component is restricted to a sub-AAF in the thread that searches it,
+// so its data resides on the NUMA node of that thread
+void* __component_pool__worker(void* arg){
+  struct ComponentPool* pool = arg;
+  int* sub_ids = malloc((pool->aaf->number_of_arguments > 0 ? pool->aaf->number_of_arguments : 1) * sizeof(int));
+  for(int i = 0; i < pool->aaf->number_of_arguments; i++)
+    sub_ids[i] = -1;
+  while(!__atomic_load_n(&pool->stop,__ATOMIC_RELAXED)){
+    int t = __atomic_fetch_add(&pool->next_task,1,__ATOMIC_RELAXED);
+    if(t >= pool->number_of_tasks)
       break;
-    //pick 1.) a mislabled argument at random or
-    // 2.) do a greedy move, or
-    // 3.) pick an arbitrary argument at random
-    int sel_arg;
-    float prob = (float)rand() / (float)RAND_MAX;
-    if(prob < greedyprob && mislabeled_pqueue->length>0){
-      sel_arg = *binaryheap__extract_minimum(mislabeled_pqueue);
-    }else if(prob < greedyprob + randsel){
-      // select some argument that is not in/out the grounded labeling
-      do{
-        sel_arg = rand() % aaf->number_of_arguments;
-      }while(bitset__get(grounded->in,sel_arg)|| bitset__get(grounded->out,sel_arg));
-    }else{
-      sel_arg = raset__random_element(mislabeled);
-    }
-    // reset toBeChecked
-    raset__reset(toBeChecked);
-    // if the selected argument is a member of an odd cycle and there is no
-    // argument attacking that cycle labelled in, select such an attacker instead
-    // (only if odd cycles have been computed)
-    if(occ != NULL && occ__contains(occ,sel_arg)){
-      struct RaSet* attackers = occ__get_attackers(occ,sel_arg);
-      // if there is at least one attacker already labelled in, everything is fine
-      int all_out = TRUE;
-      for(int i = 0; i < attackers->number_of_elements; i++)
-        if(bitset__get(lab->in, raset__get(attackers, i))){
-          all_out = FALSE;
-          break;
-        }
-      // select an attacker at random (but not an argument already labeled out
-      // in the grounded labeling)
-      if(all_out){
-        sel_arg = raset__random_element_with_skip(attackers,grounded->out);
-        if(sel_arg == -1){
-          // all attackers of the odd cycle are out in the grounded labeling
-          // this means there cannot be a stable labeling
-          break;
-        }
-      }
-    }
-    // toggle label
-    if(taas__lab_get_label(lab,sel_arg) == LAB_IN){
-      bitset__unset(lab->in,sel_arg);
-      // add the argument itself to toBeChecked
-      raset__add(toBeChecked,sel_arg);
-    }else{
-      // if the selected argument is self-attacking, select
-      // an attacker of that argument instead
-      if(bitset__get(aaf->loops,sel_arg)){
-        int number_of_attackers = aaf->parents->length;
-        // if there is no attacker there cannot be a stable extension
-        if(number_of_attackers == 0)
-             break;
-        // pick new argument (but not an argument labeled out in the grounded labeling)
-        void* r = llist__get_with_skip(aaf->parents,rand() % number_of_attackers,grounded->out);
-        if(r == NULL){
-          // all attackers of the loop are out in the grounded labeling
-          // this means there cannot be a stable labeling
-          break;
-        }else sel_arg = *(int*) r;
-      }
-      // label it in
-      bitset__set(lab->in,sel_arg);
-      // add the argument itself to toBeChecked
-      raset__add(toBeChecked,sel_arg);
-      // if "enforceout" is true then all arguments in the neighbourhood are
-      // labeled out
-      // NOTE: by doing so we cannot accidently re-label an argument from the
-      // grounded extension
-      if(enforce_out){
-        //while setting the neighbourhood to out,
-        //add the indirect neighbourhood to toBeChecked
-        for(struct LinkedListNode* node = aaf->children[sel_arg].root; node != NULL; node = node->next){
-          bitset__unset(lab->in, *(int*)node->data);
-          for(struct LinkedListNode* node2 = aaf->children[*(int*)node->data].root; node2 != NULL; node2 = node2->next)
-            raset__add(toBeChecked,*(int*)node2->data);
-          for(struct LinkedListNode* node2 = aaf->parents[*(int*)node->data].root; node2 != NULL; node2 = node2->next)
-            raset__add(toBeChecked,*(int*)node2->data);
-        }
-        for(struct LinkedListNode* node = aaf->parents[sel_arg].root; node != NULL; node = node->next){
-          bitset__unset(lab->in, *(int*)node->data);
-          for(struct LinkedListNode* node2 = aaf->children[*(int*)node->data].root; node2 != NULL; node2 = node2->next)
-            raset__add(toBeChecked,*(int*)node2->data);
-          for(struct LinkedListNode* node2 = aaf->parents[*(int*)node->data].root; node2 != NULL; node2 = node2->next)
-            raset__add(toBeChecked,*(int*)node2->data);
-        }
-      }
-    }
-    //add the direct neighbourhood to toBeChecked
-    for(struct LinkedListNode* node = aaf->children[sel_arg].root; node != NULL; node = node->next)
-      raset__add(toBeChecked,*(int*)node->data);
-    for(struct LinkedListNode* node = aaf->parents[sel_arg].root; node != NULL; node = node->next)
-      raset__add(toBeChecked,*(int*)node->data);
-    // check direct/indirect neighbourhood of selected argument for changes; skip
-    // arguments in/out from the grounded labeling, they are always correct
-    for(int i = 0 ; i < toBeChecked->number_of_elements; i++){
-      int elem = raset__get(toBeChecked,i);
-      if(!bitset__get(grounded->in,elem)&&!bitset__get(grounded->out,elem)){
-        int labeled_correctly = taas__labeled_correctly(aaf,lab,elem);
-        if(!labeled_correctly)
-          raset__add(mislabeled,elem);
-        else
-          raset__remove(mislabeled,elem);
-        // update greedy structures
-        if(greedyprob > 0 && (!labeled_correctly || greedyincall))
-          binaryheap__update(mislabeled_pqueue,&all_arguments[elem],get_flipping_count(aaf,lab,elem));
-        else if(greedyprob > 0 && labeled_correctly && !greedyincall && binaryheap__contains(mislabeled_pqueue,&all_arguments[elem])){
-          binaryheap__remove(mislabeled_pqueue,&all_arguments[elem]);
-        }
-      }
-    }
-  }while(mislabeled->number_of_elements > 0);
-  //------------------
-  // MAIN LOOP - END
-  //------------------
-  // it seems we found a stable labeling
-  if(mislabeled->number_of_elements == 0)
-    printf("%s\n",taas__lab_print(lab,aaf));
+    struct ComponentTask* task = &pool->tasks[t];
+    struct AAF* sub = taas__aaf_restrict_list(pool->aaf,task->arguments,task->number_of_arguments,NULL,sub_ids);
+    task->in = malloc(sizeof(struct BitSet));
+    bitset__init(task->in,sub->number_of_arguments);
+    if(!search_part(pool->task,sub,1,&pool->stop,&task->rng,task->in))
+      __atomic_store_n(&pool->stop,TRUE,__ATOMIC_RELAXED);
+    taas__aaf_destroy(sub);
+  }
+  free(sub_ids);
+  return NULL;
+}
+
+/**
+ * Searches for a stable extension of the given AAF by searching each of its
+ * weakly connected components (given by wcc__components()) independently,
+ * using up to "threads" threads; the stable extensions of the AAF are exactly
+ * the unions of stable extensions of its components. The largest components
+ * are taken first, and no further components are searched once some
+ * component has no stable extension. Stores the stable extension found in
+ * "in" (initialised with the number of arguments) and returns TRUE iff
+ * one has been found.
+ */
+int search_components(struct TaskSpecification *task, struct AAF* aaf, int* component, int number_of_components, int threads, struct Rng* rng, struct BitSet* in){
+  struct ComponentPool pool;
+  pool.task = task;
+  pool.aaf = aaf;
+  pool.number_of_tasks = number_of_components;
+  pool.next_task = 0;
+  pool.stop = FALSE;
+  pool.tasks = calloc(number_of_components, sizeof(struct ComponentTask));
+  // group the arguments by component
+  int* arguments = malloc((aaf->number_of_arguments > 0 ? aaf->number_of_arguments : 1) * sizeof(int));
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    pool.tasks[component[i]].number_of_arguments++;
+  int offset = 0;
+  for(int c = 0; c < number_of_components; c++){
+    pool.tasks[c].arguments = arguments + offset;
+    offset += pool.tasks[c].number_of_arguments;
+    pool.tasks[c].number_of_arguments = 0;
+    // the streams are split off in the order of the components (each is
+    // 2^128 steps ahead of the previous one), so they do not overlap and
+    // runs are reproducible
+    pool.tasks[c].rng = *rng;
+    rng__jump(rng);
+  }
+  for(int i = 0; i < aaf->number_of_arguments; i++){
+    struct ComponentTask* t = &pool.tasks[component[i]];
+    t->arguments[t->number_of_arguments++] = i;
+  }
+  qsort(pool.tasks,number_of_components,sizeof(struct ComponentTask),__component_task__compare);
+  if(threads > number_of_components)
+    threads = number_of_components;
+  pthread_t* workers = malloc(threads * sizeof(pthread_t));
+  int started = 0;
+  for(int t = 1; t < threads; t++){
+    if(pthread_create(&workers[t],NULL,__component_pool__worker,&pool) != 0)
+      break;
+    started = t;
+  }
+  __component_pool__worker(&pool);
+  for(int t = 1; t <= started; t++)
+    pthread_join(workers[t],NULL);
+  free(workers);
+  int found = !pool.stop;
+  bitset__unsetAll(in);
+  for(int c = 0; c < number_of_components; c++){
+    if(pool.tasks[c].in == NULL)
+      continue;
+    struct BitSetIterator it;
+    bitset__iterator_init(&it,pool.tasks[c].in);
+    for(int arg = bitset__iterator_next(&it); arg != -1; arg = bitset__iterator_next(&it))
+      bitset__set(in,pool.tasks[c].arguments[arg]);
+    bitset__destroy(pool.tasks[c].in);
+  }
+  free(arguments);
+  free(pool.tasks);
+  return found;
+}
+
+// prints the given extension of the AAF after an independent certificate
+// check (or "NO" if it is not stable)
+void print_extension(struct AAF* aaf, struct BitSet* in, int threads){
+  if(taas__verify_stable(aaf,in,threads)){
+    struct Labeling extension;
+    extension.in = in;
+    extension.out = NULL;
+    extension.twoValued = TRUE;
+    char* str = taas__lab_print(&extension,aaf);
+    printf("%s\n",str);
+    free(str);
+  }else{
+    fprintf(stderr,"taas-haywood: the labeling found is not stable\n");
+    printf("NO\n");
+  }
+}
+
+/**
+ * Solve SE-ST
+ */
+void solve(struct TaskSpecification *task, struct AAF* aaf, struct Labeling* grounded){
+  // do some intialising
+  struct Rng rng;
+  init_rng(task,&rng);
+  int threads = init_threads(task);
+  // AAFs without odd cycles always have a stable extension, which can be
+  // constructed directly from the grounded labeling
+  if(taas__aaf_odd_cycle_free(aaf)){
+    struct BitSet* in = malloc(sizeof(struct BitSet));
+    bitset__init(in, aaf->number_of_arguments);
+    if(taas__odd_cycle_free_stable(aaf,grounded,in))
+      print_extension(aaf,in,threads);
+    else
+      printf("NO\n");
+    bitset__destroy(in);
+    return;
+  }
+  // check some sufficient conditions for the non-existence of a stable extension
+  int rule = taas__refute_stable(aaf,grounded);
+  if(rule != REFUTATION_NONE){
+    fprintf(stderr,"taas-haywood: no stable extension (%s)\n",taas__refutation_name(rule));
+    printf("NO\n");
+    return;
+  }
+  // extend the grounded labeling by the labels every stable labeling has
+  struct Labeling* forced = malloc(sizeof(struct Labeling));
+  taas__lab_init(forced,FALSE);
+  bitset__clone(grounded->in,forced->in);
+  bitset__clone(grounded->out,forced->out);
+  if(taas__propagate_stable(aaf,forced) == PROPAGATION_CONTRADICTION){
+    fprintf(stderr,"taas-haywood: no stable extension (contradiction in propagation)\n");
+    printf("NO\n");
+    taas__lab_destroy(forced);
+    return;
+  }
+  // the search runs on the residual AAF of the arguments that are neither in
+  // the propagated labeling nor attacked by an argument in it; arguments
+  // labeled out but not (yet) attacked stay in the residual AAF as
+  // self-attacking arguments (so they are out and need an attacker in);
+  // then the stable extensions of aaf are exactly the unions of forced->in
+  // with the stable extensions of the residual AAF
+  struct BitSet* attacked = malloc(sizeof(struct BitSet));
+  bitset__init(attacked, aaf->number_of_arguments);
+  taas__compute_attacked(aaf,forced->in,attacked,NULL,threads);
+  struct BitSet* remaining = malloc(sizeof(struct BitSet));
+  bitset__init(remaining, aaf->number_of_arguments);
+  bitset__setAll(remaining);
+  bitset__andnot(remaining,forced->in);
+  bitset__andnot(remaining,attacked);
+  bitset__andnot(forced->out,attacked);
+  struct AAF* residual = taas__aaf_restrict(aaf,remaining,forced->out);
+  bitset__destroy(attacked);
+  bitset__destroy(remaining);
+  // twins (arguments with the same attackers and attackees) have the same
+  // label in every stable labeling, so the search only keeps one of each class
+  int* twin_of = malloc((residual->number_of_arguments > 0 ? residual->number_of_arguments : 1) * sizeof(int));
+  struct BitSet* representatives = malloc(sizeof(struct BitSet));
+  bitset__init(representatives, residual->number_of_arguments);
+  struct AAF* collapsed = NULL;
+  if(taas__twins(residual,twin_of,representatives) < residual->number_of_arguments)
+    collapsed = taas__aaf_restrict(residual,representatives,NULL);
+  bitset__destroy(representatives);
+  struct AAF* search = collapsed != NULL ? collapsed : residual;
+  // the search runs independently on each weakly connected component
+  int* component = malloc((search->number_of_arguments > 0 ? search->number_of_arguments : 1) * sizeof(int));
+  int number_of_components = wcc__components(search,component);
+  struct BitSet* search_in = malloc(sizeof(struct BitSet));
+  bitset__init(search_in, search->number_of_arguments);
+  int found;
+  if(number_of_components <= 1)
+    found = search_part(task,search,threads,NULL,&rng,search_in);
   else
+    found = search_components(task,search,component,number_of_components,threads,&rng,search_in);
+  free(component);
+  if(found){
+    // map the labeling back to the original AAF
+    struct BitSet* residual_in = search_in;
+    if(collapsed != NULL){
+      residual_in = malloc(sizeof(struct BitSet));
+      bitset__init(residual_in, residual->number_of_arguments);
+      bitset__unsetAll(residual_in);
+      taas__aaf_lift(collapsed,search_in,residual_in);
+      taas__twins_expand(residual,twin_of,residual_in);
+    }
+    struct BitSet* extension = malloc(sizeof(struct BitSet));
+    bitset__clone(forced->in,extension);
+    taas__aaf_lift(residual,residual_in,extension);
+    if(collapsed != NULL)
+      bitset__destroy(residual_in);
+    print_extension(aaf,extension,threads);
+    bitset__destroy(extension);
+  }else
     printf("NO\n");
   // free some variables
-  if(occ != NULL)
-    occ__destroy(occ);
-  taas__lab_destroy(lab);
-  raset__destroy(mislabeled);
-  if(mislabeled_pqueue != NULL)
-    binaryheap__destroy(mislabeled_pqueue);
+  bitset__destroy(search_in);
+  taas__lab_destroy(forced);
+  if(collapsed != NULL)
+    taas__aaf_destroy(collapsed);
+  free(twin_of);
+  taas__aaf_destroy(residual);
   return;
 }
 
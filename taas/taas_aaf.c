@@ -19,34 +19,262 @@ struct AAF{
   /** The number of arguments. */
   int number_of_arguments;
   /** The number of attacks. */
-  int number_of_attacks;
+  long number_of_attacks;
+  /** Holds argument names, the adjacency lists' nodes, and "arguments" (released with the AAF) */
+  struct Arena* arena;
+  /** For providing pointers to all arguments (arguments[i] = i) */
+  int* arguments;
   /** Maps arguments to their children */
   struct LinkedList* children;
   /** Maps arguments to their parents */
   struct LinkedList* parents;
+  /** The children of argument i are children_arr[children_idx[i]],...,children_arr[children_idx[i+1]-1] */
+  long* children_idx;
+  int* children_arr;
+  /** The parents of argument i are parents_arr[parents_idx[i]],...,parents_arr[parents_idx[i+1]-1] */
+  long* parents_idx;
+  int* parents_arr;
   /** The initial arguments (unattacked ones) */
   struct BitSet* initial;
   /** Self-attacking arguments */
   struct BitSet* loops;
+  /** Whether every attack (except self-attacks) is mutual */
+  char symmetric;
+  /** Whether the adjacency bit matrices below are available */
+  char dense;
+  /** Adjacency matrix, row i contains the children of i (only if dense) */
+  struct BitMatrix* children_matrix;
+  /** Transposed adjacency matrix, row i contains the parents of i (only if dense) */
+  struct BitMatrix* parents_matrix;
+  /** If this AAF has been obtained by taas__aaf_restrict(): argument i is argument
+      original_ids[i] of the original AAF (NULL otherwise) */
+  int* original_ids;
 };
 
 void taas__aaf_destroy(struct AAF* aaf){
-  for(int i = 0; i < aaf->number_of_arguments; i++)
-		free(aaf->ids2arguments[i]);
 	free(aaf->ids2arguments);
-  llist__destroy(aaf->children);
-  llist__destroy(aaf->parents);
-	hash__destroy(aaf->arguments2ids);
+  free(aaf->children);
+  free(aaf->parents);
+  bitset__destroy(aaf->initial);
+  bitset__destroy(aaf->loops);
+  mem__free(aaf->children_idx);
+  mem__free(aaf->children_arr);
+  mem__free(aaf->parents_idx);
+  mem__free(aaf->parents_arr);
+  if(aaf->arguments2ids != NULL)
+	  hash__destroy(aaf->arguments2ids);
+  free(aaf->original_ids);
+  if(aaf->dense){
+    bitmatrix__destroy(aaf->children_matrix);
+    bitmatrix__destroy(aaf->parents_matrix);
+  }
+  arena__destroy(aaf->arena);
   free(aaf);
 }
 
+// Returns the attack density of the AAF, i.e. the number of attacks divided
+// by the number of possible attacks
+double taas__aaf_density(struct AAF* aaf){
+  if(aaf->number_of_arguments == 0)
+    return 0;
+  return (double)aaf->number_of_attacks / ((double)aaf->number_of_arguments * (double)aaf->number_of_arguments);
+}
+
+// Builds the adjacency bit matrices of the AAF (in addition to the
+// adjacency lists); afterwards aaf->dense is TRUE
+void taas__aaf_init_dense(struct AAF* aaf){
+  if(aaf->dense)
+    return;
+  aaf->children_matrix = malloc(sizeof(struct BitMatrix));
+  aaf->parents_matrix = malloc(sizeof(struct BitMatrix));
+  bitmatrix__init(aaf->children_matrix, aaf->number_of_arguments, aaf->number_of_arguments);
+  bitmatrix__init(aaf->parents_matrix, aaf->number_of_arguments, aaf->number_of_arguments);
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++){
+      bitmatrix__set(aaf->children_matrix, i, aaf->children_arr[k]);
+      bitmatrix__set(aaf->parents_matrix, aaf->children_arr[k], i);
+    }
+  aaf->dense = TRUE;
+}
+
 // Returns TRUE iff i attacks j
 int taas__aaf_isAttack(struct AAF* aaf, int i, int j){
-  for(struct LinkedListNode* node = aaf->children[i].root; node != NULL; node = node->next)
-    if(*(int*)node->data == j)
+  for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+    if(aaf->children_arr[k] == j)
       return TRUE;
   return FALSE;
 }
+
+// Determines whether every attack of the AAF (except self-attacks) is mutual,
+// i.e., whether every argument has the same children and parents; uses the
+// adjacency arrays and takes linear time
+void taas__aaf_init_symmetric(struct AAF* aaf){
+  aaf->symmetric = TRUE;
+  // stamp[j] == i+1 iff j has been seen as a neighbour of i
+  int* stamp = calloc(aaf->number_of_arguments > 0 ? aaf->number_of_arguments : 1, sizeof(int));
+  for(int i = 0; i < aaf->number_of_arguments && aaf->symmetric; i++){
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      stamp[aaf->children_arr[k]] = i+1;
+    for(long k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++)
+      if(stamp[aaf->parents_arr[k]] != i+1){
+        aaf->symmetric = FALSE;
+        break;
+      }
+    for(long k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++)
+      stamp[aaf->parents_arr[k]] = -(i+1);
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      if(stamp[aaf->children_arr[k]] != -(i+1)){
+        aaf->symmetric = FALSE;
+        break;
+      }
+  }
+  free(stamp);
+}
+
+// Builds the adjacency arrays (children_idx/children_arr, parents_idx/parents_arr)
+// from the adjacency lists; offsets are 64-bit so that the number of attacks
+// may exceed 2^31
+void taas__aaf_init_arrays(struct AAF* aaf){
+  aaf->children_idx = mem__alloc((aaf->number_of_arguments+1) * sizeof(long));
+  aaf->parents_idx = mem__alloc((aaf->number_of_arguments+1) * sizeof(long));
+  aaf->children_arr = mem__alloc((aaf->number_of_attacks > 0 ? aaf->number_of_attacks : 1) * sizeof(int));
+  aaf->parents_arr = mem__alloc((aaf->number_of_attacks > 0 ? aaf->number_of_attacks : 1) * sizeof(int));
+  aaf->children_idx[0] = 0;
+  aaf->parents_idx[0] = 0;
+  for(int i = 0; i < aaf->number_of_arguments; i++){
+    long k = aaf->children_idx[i];
+    for(struct LinkedListNode* node = aaf->children[i].root; node != NULL; node = node->next)
+      aaf->children_arr[k++] = *(int*)node->data;
+    aaf->children_idx[i+1] = k;
+    k = aaf->parents_idx[i];
+    for(struct LinkedListNode* node = aaf->parents[i].root; node != NULL; node = node->next)
+      aaf->parents_arr[k++] = *(int*)node->data;
+    aaf->parents_idx[i+1] = k;
+  }
+  taas__aaf_init_symmetric(aaf);
+}
+
+// Returns the sub-AAF of the given AAF induced by the n arguments in the
+// (ascending) array "args", where additionally the arguments in "loops" (if
+// not NULL) attack themselves; argument i of the sub-AAF is argument args[i]
+// of aaf. "sub_ids" must have an entry -1 for every argument of aaf and is
+// restored before returning, so the time needed only depends on the size of
+// the sub-AAF. Argument names are shared with aaf, so aaf has to be destroyed
+// after the sub-AAF; the sub-AAF has no mapping from names to arguments.
+struct AAF* taas__aaf_restrict_list(struct AAF* aaf, int* args, int n, struct BitSet* loops, int* sub_ids){
+  struct AAF* sub = malloc(sizeof(struct AAF));
+  sub->number_of_arguments = n;
+  sub->dense = FALSE;
+  sub->arena = arena__init();
+  sub->arguments2ids = NULL;
+  sub->ids2arguments = malloc((n > 0 ? n : 1) * sizeof(char*));
+  sub->original_ids = malloc((n > 0 ? n : 1) * sizeof(int));
+  sub->arguments = arena__alloc(sub->arena, n * sizeof(int));
+  for(int idx = 0; idx < n; idx++){
+    int arg = args[idx];
+    sub->arguments[idx] = idx;
+    sub->original_ids[idx] = arg;
+    sub->ids2arguments[idx] = aaf->ids2arguments[arg];
+    sub_ids[arg] = idx;
+  }
+  // adjacency arrays and lists
+  sub->number_of_attacks = 0;
+  for(int i = 0; i < n; i++){
+    int arg = sub->original_ids[i];
+    for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+      if(sub_ids[aaf->children_arr[k]] != -1)
+        sub->number_of_attacks++;
+    if(loops != NULL && bitset__get(loops,arg) && !bitset__get(aaf->loops,arg))
+      sub->number_of_attacks++;
+  }
+  sub->children_idx = mem__alloc((n+1) * sizeof(long));
+  sub->parents_idx = mem__alloc((n+1) * sizeof(long));
+  sub->children_arr = mem__alloc((sub->number_of_attacks > 0 ? sub->number_of_attacks : 1) * sizeof(int));
+  sub->parents_arr = mem__alloc((sub->number_of_attacks > 0 ? sub->number_of_attacks : 1) * sizeof(int));
+  sub->children = malloc((n > 0 ? n : 1) * sizeof(struct LinkedList));
+  sub->parents = malloc((n > 0 ? n : 1) * sizeof(struct LinkedList));
+  sub->initial = malloc(sizeof(struct BitSet));
+  bitset__init(sub->initial, n);
+  bitset__setAll(sub->initial);
+  sub->loops = malloc(sizeof(struct BitSet));
+  bitset__init(sub->loops, n);
+  bitset__unsetAll(sub->loops);
+  sub->children_idx[0] = 0;
+  sub->parents_idx[0] = 0;
+  for(int i = 0; i < n; i++){
+    int arg = sub->original_ids[i];
+    llist__init_in(&sub->children[i],sub->arena);
+    llist__init_in(&sub->parents[i],sub->arena);
+    long k2 = sub->children_idx[i];
+    for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++){
+      int child = sub_ids[aaf->children_arr[k]];
+      if(child == -1)
+        continue;
+      sub->children_arr[k2++] = child;
+      llist__add(&sub->children[i],&sub->arguments[child]);
+      bitset__unset(sub->initial,child);
+      if(child == i)
+        bitset__set(sub->loops,i);
+    }
+    int new_loop = loops != NULL && bitset__get(loops,arg) && !bitset__get(aaf->loops,arg);
+    if(new_loop){
+      sub->children_arr[k2++] = i;
+      llist__add(&sub->children[i],&sub->arguments[i]);
+      bitset__unset(sub->initial,i);
+      bitset__set(sub->loops,i);
+    }
+    sub->children_idx[i+1] = k2;
+    k2 = sub->parents_idx[i];
+    for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+      int parent = sub_ids[aaf->parents_arr[k]];
+      if(parent == -1)
+        continue;
+      sub->parents_arr[k2++] = parent;
+      llist__add(&sub->parents[i],&sub->arguments[parent]);
+    }
+    if(new_loop){
+      sub->parents_arr[k2++] = i;
+      llist__add(&sub->parents[i],&sub->arguments[i]);
+    }
+    sub->parents_idx[i+1] = k2;
+  }
+  for(int i = 0; i < n; i++)
+    sub_ids[args[i]] = -1;
+  taas__aaf_init_symmetric(sub);
+  return sub;
+}
+
+// Returns the sub-AAF of the given AAF induced by the given set of arguments,
+// where additionally the arguments in "loops" (if not NULL) attack themselves;
+// argument i of the sub-AAF is argument original_ids[i] of aaf (the order of
+// the arguments is preserved), see taas__aaf_restrict_list().
+struct AAF* taas__aaf_restrict(struct AAF* aaf, struct BitSet* arguments, struct BitSet* loops){
+  int n = bitset__count(arguments);
+  int* args = malloc((n > 0 ? n : 1) * sizeof(int));
+  // maps the arguments of aaf to those of the sub-AAF (or -1)
+  int* sub_ids = malloc((aaf->number_of_arguments > 0 ? aaf->number_of_arguments : 1) * sizeof(int));
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    sub_ids[i] = -1;
+  struct BitSetIterator it;
+  bitset__iterator_init(&it,arguments);
+  int idx = 0;
+  for(int arg = bitset__iterator_next(&it); arg != -1; arg = bitset__iterator_next(&it))
+    args[idx++] = arg;
+  struct AAF* sub = taas__aaf_restrict_list(aaf,args,n,loops,sub_ids);
+  free(args);
+  free(sub_ids);
+  return sub;
+}
+
+// Adds the arguments of the original AAF that correspond to the given set of
+// arguments of a sub-AAF (obtained by taas__aaf_restrict()) to "lifted"
+void taas__aaf_lift(struct AAF* sub, struct BitSet* arguments, struct BitSet* lifted){
+  struct BitSetIterator it;
+  bitset__iterator_init(&it,arguments);
+  for(int arg = bitset__iterator_next(&it); arg != -1; arg = bitset__iterator_next(&it))
+    bitset__set(lifted,sub->original_ids[arg]);
+}
+
 /* ============================================================================================================== */
 /* == END FILE ================================================================================================== */
 /* ============================================================================================================== */
@@ -69,7 +69,9 @@ int taas__compute_grounded(struct TaskSpecification *task, struct AAF* aaf, stru
   bitset__unsetAll(grounded->out);
 	struct BinaryHeap* heap = malloc(sizeof(struct BinaryHeap));
 	binaryheap__init(heap, aaf->number_of_arguments);
-  for(int a = bitset__next_set_bit(grounded->in,0); a != -1 ; a = bitset__next_set_bit(grounded->in, a+1)){
+	struct BitSetIterator it;
+	bitset__iterator_init(&it,grounded->in);
+  for(int a = bitset__iterator_next(&it); a != -1 ; a = bitset__iterator_next(&it)){
 		for(struct LinkedListNode* node = aaf->children[a].root; node != NULL; node = node->next){
 			// check if we can already provide an answer for the problem
 			if(*(int*)node->data == task->arg){
@@ -165,6 +167,8 @@ int taas__solve(int argc,
 		struct TaskSpecification *task = taas__cmd_handle(argc,argv,info);
 	  // if only solver information was asked, terminate
 		if(task != NULL){
+	    // set up allocation of large arrays
+	    taas__init_memory(task);
 	    // read file
 	    struct AAF *aaf = malloc(sizeof(struct AAF));
 	    taas__readFile(task->file,aaf);
@@ -193,9 +197,13 @@ int taas__solve(int argc,
 	    }else if(ans == COMPUTATION_ABORTED__ANSWER_EMPTYEMPTYSET){
 	  		printf("[\n[]\n]\n");
 	    }else if(strcmp(task->track,"SE-GR") == 0 || strcmp(task->track, "SE-CO") == 0 ){
-	      printf("%s\n",taas__lab_print(grounded,aaf));
+	      char* str = taas__lab_print(grounded,aaf);
+	      printf("%s\n",str);
+	      free(str);
 	    }else if(strcmp(task->track,"EE-GR") == 0){
-	      printf("[\n%s\n]\n",taas__lab_print(grounded,aaf));
+	      char* str = taas__lab_print(grounded,aaf);
+	      printf("[\n%s\n]\n",str);
+	      free(str);
 	    }else{
 	      // at this point DS_GR, DC_GR, EE_GR, SE_GR, SE_CO, DS_CO are solved
 				// if grounded has not been computed yet, it is empty
@@ -213,12 +221,108 @@ int taas__solve(int argc,
 	    if(bool_grounded_init) taas__lab_destroy(grounded);
 	    // destroy aaf
 	    taas__aaf_destroy(aaf);
+	    taas__cmd_destroy(task);
 	  }
 	  taas__solverinformation_destroy(info);
-	  taas__cmd_destroy(task);
 		return 0;
 }
 
+/**
+ * Variant of taas__labeled_correctly() for two-valued labelings on AAFs
+ * with adjacency bit matrices: an argument labeled "in" is correct iff its row
+ * in the (transposed) adjacency matrix does not intersect lab->in, an argument
+ * labeled "out" is correct iff its row in the transposed adjacency matrix does.
+ */
+int taas__labeled_correctly_dense(struct AAF* aaf, struct Labeling* lab, int arg){
+	if(bitset__get(lab->in,arg))
+		return !bitmatrix__rows_intersect(aaf->children_matrix,aaf->parents_matrix,arg,lab->in);
+	return bitmatrix__rows_intersect(aaf->parents_matrix,NULL,arg,lab->in);
+}
+
+/**
+ * Variant of taas__labeled_correctly_under_assumption() for two-valued
+ * labelings on AAFs with adjacency bit matrices. If arg_other is a neighbour
+ * of arg the number of "in" neighbours is counted and corrected by the
+ * assumed label of arg_other.
+ */
+int taas__labeled_correctly_under_assumption_dense(struct AAF* aaf, struct Labeling* lab, int arg, int arg_other, int lab_other){
+	int label = arg == arg_other ? lab_other : (bitset__get(lab->in,arg) ? LAB_IN : LAB_OUT);
+	struct BitMatrix* parents_or_neighbours = label == LAB_IN ? aaf->children_matrix : NULL;
+	int is_neighbour = bitmatrix__get(aaf->parents_matrix,arg,arg_other) ||
+		(parents_or_neighbours != NULL && bitmatrix__get(aaf->children_matrix,arg,arg_other));
+	int in_neighbours;
+	if(!is_neighbour)
+		in_neighbours = bitmatrix__rows_intersect(aaf->parents_matrix,parents_or_neighbours,arg,lab->in);
+	else{
+		in_neighbours = bitmatrix__rows_and_count(aaf->parents_matrix,parents_or_neighbours,arg,lab->in);
+		in_neighbours -= bitset__get(lab->in,arg_other) ? 1 : 0;
+		in_neighbours += lab_other == LAB_IN ? 1 : 0;
+	}
+	if(label == LAB_IN)
+		return in_neighbours == 0;
+	return in_neighbours > 0;
+}
+
+/**
+ * Variant of taas__labeled_correctly() for two-valued labelings on AAFs
+ * without adjacency bit matrices.
+ */
+int taas__labeled_correctly_sparse(struct AAF* aaf, struct Labeling* lab, int arg){
+	if(bitset__get(lab->in,arg)){
+		for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+			if(bitset__get(lab->in,aaf->children_arr[k]))
+				return FALSE;
+		for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(bitset__get(lab->in,aaf->parents_arr[k]))
+				return FALSE;
+		return TRUE;
+	}
+	for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+		if(bitset__get(lab->in,aaf->parents_arr[k]))
+			return TRUE;
+	return FALSE;
+}
+
+/**
+ * Variant of taas__labeled_correctly_under_assumption() for two-valued labelings on AAFs
+ * without adjacency bit matrices.
+ */
+int taas__labeled_correctly_under_assumption_sparse(struct AAF* aaf, struct Labeling* lab, int arg, int arg_other, int lab_other){
+	int in_other = lab_other == LAB_IN;
+	if(arg == arg_other ? in_other : bitset__get(lab->in,arg)){
+		for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+			if(aaf->children_arr[k] == arg_other ? in_other : bitset__get(lab->in,aaf->children_arr[k]))
+				return FALSE;
+		for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(aaf->parents_arr[k] == arg_other ? in_other : bitset__get(lab->in,aaf->parents_arr[k]))
+				return FALSE;
+		return TRUE;
+	}
+	for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+		if(aaf->parents_arr[k] == arg_other ? in_other : bitset__get(lab->in,aaf->parents_arr[k]))
+			return TRUE;
+	return FALSE;
+}
+
+/**
+ * Checks whether the argument "arg" is correctly labeled in the given two-valued
+ * labeling (only "in" and "out") wrt. the given AAF; uses the adjacency bit matrices
+ * if "dense" is TRUE (then they must be available). Callers that know "dense" at
+ * compile time get a branch-free check.
+ */
+static inline int taas__labeled_correctly_twovalued(struct AAF* aaf, struct Labeling* lab, int arg, int dense){
+	return dense ? taas__labeled_correctly_dense(aaf,lab,arg) : taas__labeled_correctly_sparse(aaf,lab,arg);
+}
+
+/**
+ * Like taas__labeled_correctly_twovalued() but under the assumption that
+ * arg_other is labelled lab_other.
+ */
+static inline int taas__labeled_correctly_under_assumption_twovalued(struct AAF* aaf, struct Labeling* lab, int arg, int arg_other, int lab_other, int dense){
+	return dense ? taas__labeled_correctly_under_assumption_dense(aaf,lab,arg,arg_other,lab_other) :
+		taas__labeled_correctly_under_assumption_sparse(aaf,lab,arg,arg_other,lab_other);
+}
+
 /**
  * Checks wheter the argument "arg" is correctly labeled in
  * the given labeling wrt. the given AAF , i.e.
@@ -234,28 +338,28 @@ int taas__labeled_correctly(struct AAF* aaf, struct Labeling* lab, int arg){
 	int label = taas__lab_get_label(lab,arg);
 	if(label == LAB_IN){
 		// argument is "in"
-		for(struct LinkedListNode* node = aaf->children[arg].root; node != NULL; node = node->next)
-			if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+		for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+			if(taas__lab_get_label(lab,aaf->children_arr[k]) != LAB_OUT)
 				return FALSE;
-		for(struct LinkedListNode* node = aaf->parents[arg].root; node != NULL; node = node->next)
-			if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+		for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(taas__lab_get_label(lab,aaf->parents_arr[k]) != LAB_OUT)
 				return FALSE;
 		return TRUE;
 	}
 	if(label == LAB_OUT){
 		// argument is "out"
-		for(struct LinkedListNode* node = aaf->parents[arg].root; node != NULL; node = node->next)
-			if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+		for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(taas__lab_get_label(lab,aaf->parents_arr[k]) == LAB_IN)
 				return TRUE;
 		return FALSE;
 	}
 	// argument is "undec"
-	for(struct LinkedListNode* node = aaf->children[arg].root; node != NULL; node = node->next)
-		if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+	for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+		if(taas__lab_get_label(lab,aaf->children_arr[k]) == LAB_IN)
 			return FALSE;
 	int undec_attacker = FALSE;
-	for(struct LinkedListNode* node = aaf->parents[arg].root; node != NULL; node = node->next){
-		int attacker_label = taas__lab_get_label(lab,*(int*)node->data);
+	for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+		int attacker_label = taas__lab_get_label(lab,aaf->parents_arr[k]);
 		if(attacker_label == LAB_IN)
 			return FALSE;
 		if(attacker_label == LAB_UNDEC)
@@ -280,36 +384,36 @@ int taas__labeled_correctly_under_assumption(struct AAF* aaf, struct Labeling* l
 	int label = arg == arg_other ? lab_other : taas__lab_get_label(lab,arg);
 	if(label == LAB_IN){
 		// argument is "in"
-		for(struct LinkedListNode* node = aaf->children[arg].root; node != NULL; node = node->next)
-			if(*(int*)node->data == arg_other && lab_other != LAB_OUT)
+		for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+			if(aaf->children_arr[k] == arg_other && lab_other != LAB_OUT)
 				return FALSE;
-			else if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+			else if(taas__lab_get_label(lab,aaf->children_arr[k]) != LAB_OUT)
 				return FALSE;
-		for(struct LinkedListNode* node = aaf->parents[arg].root; node != NULL; node = node->next)
-			if(*(int*)node->data == arg_other && lab_other != LAB_OUT)
+		for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(aaf->parents_arr[k] == arg_other && lab_other != LAB_OUT)
 				return FALSE;
-			else if(taas__lab_get_label(lab,*(int*)node->data) != LAB_OUT)
+			else if(taas__lab_get_label(lab,aaf->parents_arr[k]) != LAB_OUT)
 				return FALSE;
 		return TRUE;
 	}
 	if(label == LAB_OUT){
 		// argument is "out"
-		for(struct LinkedListNode* node = aaf->parents[arg].root; node != NULL; node = node->next)
-			if(*(int*)node->data == arg_other && lab_other == LAB_IN)
+		for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+			if(aaf->parents_arr[k] == arg_other && lab_other == LAB_IN)
 				return TRUE;
-			else if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+			else if(taas__lab_get_label(lab,aaf->parents_arr[k]) == LAB_IN)
 				return TRUE;
 		return FALSE;
 	}
 	// argument is "undec"
-	for(struct LinkedListNode* node = aaf->children[arg].root; node != NULL; node = node->next)
-		if(*(int*)node->data == arg_other && lab_other != LAB_IN)
+	for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+		if(aaf->children_arr[k] == arg_other && lab_other != LAB_IN)
 			return FALSE;
-		else if(taas__lab_get_label(lab,*(int*)node->data) == LAB_IN)
+		else if(taas__lab_get_label(lab,aaf->children_arr[k]) == LAB_IN)
 			return FALSE;
 	int undec_attacker = FALSE;
-	for(struct LinkedListNode* node = aaf->parents[arg].root; node != NULL; node = node->next){
-		int attacker_label = *(int*)node->data == arg_other ? lab_other : taas__lab_get_label(lab,*(int*)node->data);
+	for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+		int attacker_label = aaf->parents_arr[k] == arg_other ? lab_other : taas__lab_get_label(lab,aaf->parents_arr[k]);
 		if(attacker_label == LAB_IN)
 			return FALSE;
 		if(attacker_label == LAB_UNDEC)
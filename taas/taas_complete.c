@@ -0,0 +1,65 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_complete.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Complete search for stable extensions with the CDCL solver:
+               the variable of an argument is true iff the argument is in;
+               every attack gives a clause (not both in) and every argument
+               a clause (in or some attacker in).
+ ============================================================================
+ */
+
+/**
+ * Decides whether the given AAF has a stable extension with the CDCL solver
+ * and stores it in "in" (initialised with the number of arguments) if so.
+ * The labeling "hint" (e.g. the last labeling of the local search; may be
+ * "in" itself or NULL) gives the initial phases of the variables. Returns
+ * CDCL_SAT, CDCL_UNSAT, or CDCL_UNKNOWN if the search has been stopped
+ * because *stop has become TRUE (if stop is not NULL).
+ */
+int taas__complete_stable(struct AAF* aaf, struct BitSet* hint, int* stop, struct BitSet* in){
+  struct CdclSolver solver;
+  cdcl__init(&solver, aaf->number_of_arguments);
+  solver.stop = stop;
+  if(hint != NULL)
+    for(int i = 0; i < aaf->number_of_arguments; i++)
+      cdcl__set_phase(&solver, i, bitset__get(hint,i));
+  int* clause = malloc((aaf->number_of_arguments + 1) * sizeof(int));
+  int ok = TRUE;
+  for(int i = 0; i < aaf->number_of_arguments && ok; i++){
+    // conflict-freeness (self-attacking arguments are out)
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1] && ok; k++){
+      int child = aaf->children_arr[k];
+      clause[0] = CDCL_LIT(i,FALSE);
+      clause[1] = CDCL_LIT(child,FALSE);
+      ok = cdcl__add_clause(&solver, clause, child == i ? 1 : 2);
+    }
+    // every argument is in or attacked by an argument in
+    int size = 0;
+    clause[size++] = CDCL_LIT(i,TRUE);
+    for(long k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++)
+      if(aaf->parents_arr[k] != i)
+        clause[size++] = CDCL_LIT(aaf->parents_arr[k],TRUE);
+    if(ok)
+      ok = cdcl__add_clause(&solver, clause, size);
+  }
+  free(clause);
+  int result = ok ? cdcl__solve(&solver) : CDCL_UNSAT;
+  if(result == CDCL_SAT){
+    bitset__unsetAll(in);
+    for(int i = 0; i < aaf->number_of_arguments; i++)
+      if(cdcl__value(&solver, i))
+        bitset__set(in,i);
+  }
+  cdcl__destroy(&solver);
+  return result;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
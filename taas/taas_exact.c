@@ -0,0 +1,105 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_exact.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Exact search for stable extensions of small AAFs (at most
+               EXACT_MAX_ARGUMENTS arguments) by branch and bound on 64-bit
+               adjacency masks.
+ ============================================================================
+ */
+
+// the maximal number of arguments of AAFs given to taas__exact_stable() by the search
+#define EXACT_MAX_ARGUMENTS 40
+
+// the state of the exact search
+struct ExactSearch{
+  int number_of_arguments;
+  // children[i] and parents[i] are the masks of the children and parents of argument i
+  uint64_t* children;
+  uint64_t* parents;
+  // all arguments
+  uint64_t all;
+  // the stable extension found
+  uint64_t result;
+};
+
+// Searches for a stable extension that contains "in", does not contain any
+// argument in "forbidden" (which contains all arguments conflicting with
+// "in"), where "covered" are the arguments in or attacked by "in".
+// Branches on the uncovered argument with the fewest candidates to cover it
+// (itself or one of its attackers); after a candidate has been tried it is
+// forbidden in the remaining branches, so no set is visited twice.
+int __exact__search(struct ExactSearch* search, uint64_t in, uint64_t covered, uint64_t forbidden){
+  uint64_t uncovered = search->all & ~covered;
+  if(uncovered == 0){
+    search->result = in;
+    return TRUE;
+  }
+  int best_count = 65;
+  uint64_t best_candidates = 0;
+  for(uint64_t rest = uncovered; rest != 0; rest &= rest - 1){
+    int arg = __builtin_ctzll(rest);
+    uint64_t candidates = ((1ULL << arg) | search->parents[arg]) & ~forbidden;
+    int count = __builtin_popcountll(candidates);
+    if(count == 0)
+      return FALSE;
+    if(count < best_count){
+      best_count = count;
+      best_candidates = candidates;
+      if(count == 1)
+        break;
+    }
+  }
+  for(uint64_t rest = best_candidates; rest != 0; rest &= rest - 1){
+    int c = __builtin_ctzll(rest);
+    uint64_t bit = 1ULL << c;
+    if(__exact__search(search, in | bit, covered | bit | search->children[c], forbidden | bit | search->children[c] | search->parents[c]))
+      return TRUE;
+    forbidden |= bit;
+  }
+  return FALSE;
+}
+
+/**
+ * Decides whether the given AAF (with at most 64 arguments) has a stable
+ * extension by exhaustive search and stores it in "in" (initialised with the
+ * number of arguments) if so; returns TRUE iff there is a stable extension.
+ * Unlike the local search, the answer is also exact if it is FALSE.
+ */
+int taas__exact_stable(struct AAF* aaf, struct BitSet* in){
+  int n = aaf->number_of_arguments;
+  struct ExactSearch search;
+  search.number_of_arguments = n;
+  search.children = calloc(n > 0 ? n : 1, sizeof(uint64_t));
+  search.parents = calloc(n > 0 ? n : 1, sizeof(uint64_t));
+  search.all = n == 64 ? ~0ULL : (1ULL << n) - 1;
+  search.result = 0;
+  for(int i = 0; i < n; i++){
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      search.children[i] |= 1ULL << aaf->children_arr[k];
+    for(long k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++)
+      search.parents[i] |= 1ULL << aaf->parents_arr[k];
+  }
+  // self-attacking arguments are never in
+  uint64_t loops = 0;
+  for(int i = 0; i < n; i++)
+    if(bitset__get(aaf->loops,i))
+      loops |= 1ULL << i;
+  int found = __exact__search(&search,0,0,loops);
+  bitset__unsetAll(in);
+  if(found)
+    for(uint64_t rest = search.result; rest != 0; rest &= rest - 1)
+      bitset__set(in,__builtin_ctzll(rest));
+  free(search.children);
+  free(search.parents);
+  return found;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -54,6 +54,13 @@ void taas__solverinformation_destroy(struct SolverInformation *info){
     free(info);
 }
 
+void taas__cmd_destroy(struct TaskSpecification *task){
+  free(task->additional_keys);
+  free(task->additional_values);
+  free(task->problem);
+  free(task);
+}
+
 /**
  * Handles the command. If basic solver information is asked for, NULL is returned;
  * otherwise the task specification is returned
@@ -66,6 +73,7 @@ struct TaskSpecification* taas__cmd_handle(int argc, char *argv[], struct Solver
   task->number_of_additional_arguments = 0;
   task->additional_keys = malloc(sizeof(char*));
   task->additional_values = malloc(sizeof(char*));
+  task->problem = NULL;
   int param = 0;
   for(int i = 1; i < argc; i++){
     if(strcmp(argv[i],"-p") == 0){
@@ -85,11 +93,13 @@ struct TaskSpecification* taas__cmd_handle(int argc, char *argv[], struct Solver
     // for the parameter "--formats" print out the formats and exit
     if(strcmp(argv[i],"--formats") == 0){
       printf("%s\n", info->formats);
+      taas__cmd_destroy(task);
       return NULL;
     }
     // for the parameter "--problems" print out the problems and exit
     if(strcmp(argv[i],"--problems") == 0){
       printf("%s\n", info->problems);
+      taas__cmd_destroy(task);
       return NULL;
     }
     // parse an additional argument
@@ -102,6 +112,7 @@ struct TaskSpecification* taas__cmd_handle(int argc, char *argv[], struct Solver
   //if no problem and file are given, just print out information
   if(param < 2){
     printf("%s\n", info->description);
+    taas__cmd_destroy(task);
     return NULL;
   }
   task->problem = malloc(3*sizeof(char));
@@ -111,10 +122,6 @@ struct TaskSpecification* taas__cmd_handle(int argc, char *argv[], struct Solver
   return task;
 }
 
-void taas__cmd_destroy(struct TaskSpecification *task){
-  free(task);
-}
-
 /**
  * Returns the value of an additional argument; if there is no
  * value with the given key, NULL is returned;
@@ -127,6 +134,21 @@ char* taas__task_get_value(struct TaskSpecification *task, char* key){
   return NULL;
 }
 
+/**
+ * Sets the allocation policy for large arrays from the parameters
+ * "-hugepages X" (1: back large arrays by huge pages (default), 0: do not) and
+ * "-numa X" ("none" (default), "interleave": interleave large arrays over all
+ * NUMA nodes)
+ */
+void taas__init_memory(struct TaskSpecification *task){
+  char* hugepages = taas__task_get_value(task,"-hugepages");
+  char* numa = taas__task_get_value(task,"-numa");
+  int numa_policy = MEM_NUMA_NONE;
+  if(numa != NULL && strcmp(numa,"interleave") == 0)
+    numa_policy = MEM_NUMA_INTERLEAVE;
+  mem__configure(hugepages != NULL ? atoi(hugepages) : TRUE, numa_policy);
+}
+
 /** Read the file into the datastructures */
 void taas__readFile(char* path, struct AAF* aaf){
   // first get the number of arguments
@@ -142,13 +164,22 @@ void taas__readFile(char* path, struct AAF* aaf){
       break;
     idx++;
   }
+  fclose(fp);
   aaf->number_of_arguments = idx;
-  // now do the actual parsing
+  aaf->dense = FALSE;
+  aaf->original_ids = NULL;
+  // now do the actual parsing; argument names and the nodes of the adjacency
+  // lists are allocated from the arena of the AAF
+  aaf->arena = arena__init();
   aaf->ids2arguments = malloc(aaf->number_of_arguments * sizeof(char*));
 	aaf->children = malloc(aaf->number_of_arguments * sizeof(struct LinkedList));
 	aaf->parents = malloc(aaf->number_of_arguments * sizeof(struct LinkedList));
   aaf->arguments2ids = malloc(sizeof(struct StringHashTable));
   hash__init(aaf->arguments2ids,aaf->number_of_arguments);
+  // for providing pointers to all arguments (the data of the adjacency lists)
+  aaf->arguments = arena__alloc(aaf->arena, aaf->number_of_arguments * sizeof(int));
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    aaf->arguments[i] = i;
 	fp = fopen(path,"r");
 	char* arg1;
 	int argumentSection = 1;
@@ -173,23 +204,20 @@ void taas__readFile(char* path, struct AAF* aaf){
 		}
 		if(argumentSection != 0){
       // parse an argument
-      arg1 = malloc(sizeof(trimwhitespace(row))+1);
-			strcpy(arg1,trimwhitespace(row));
+      arg1 = arena__strdup(aaf->arena,trimwhitespace(row));
 			aaf->ids2arguments[idx] = arg1;
 			hash__insert(aaf->arguments2ids,arg1,idx);
-			llist__init(&aaf->children[idx]);
-			llist__init(&aaf->parents[idx]);
+			llist__init_in(&aaf->children[idx],aaf->arena);
+			llist__init_in(&aaf->parents[idx],aaf->arena);
 			idx++;
 		}else{
       // parse an attack
       aaf->number_of_attacks++;
-			int *idx1 = malloc(sizeof(int));
-			int *idx2 = malloc(sizeof(int));
 			idx = 0;
 			while(row[idx] != ' ')idx++;
 			row[idx] = 0;
-			*idx1 = hash__get(aaf->arguments2ids, row);
-			*idx2 = hash__get(aaf->arguments2ids, &row[idx+1]);
+			int *idx1 = &aaf->arguments[hash__get(aaf->arguments2ids, row)];
+			int *idx2 = &aaf->arguments[hash__get(aaf->arguments2ids, &row[idx+1])];
 			llist__add(&aaf->children[*idx1],idx2);
 			llist__add(&aaf->parents[*idx2],idx1);
 			// if an argument is attacked, it is not initial
@@ -201,6 +229,8 @@ void taas__readFile(char* path, struct AAF* aaf){
 		}
 	}
 	fclose(fp);
+  free(row);
+  taas__aaf_init_arrays(aaf);
 }
 // if DS or DC problem, parse argument under consideration
 void taas__update_arg_param(struct TaskSpecification* task, struct AAF* aaf){
@@ -44,10 +44,10 @@ void taas__lab_init(struct Labeling* lab, char twoValued){
 /**
  * Randomly sets the given labeling
  */
-void taas__lab_randomize(struct Labeling* lab){
-  bitset__randomize(lab->in);
+void taas__lab_randomize(struct Labeling* lab, struct Rng* rng){
+  bitset__randomize(lab->in,rng);
   if(!lab->twoValued){
-    bitset__randomize(lab->out);
+    bitset__randomize(lab->out,rng);
     for(int i = 0; i < lab->in->num_elements; i++)
       lab->out->data[i] = lab->out->data[i] & ~lab->in->data[i];
   }
@@ -71,6 +71,14 @@ int taas__lab_get_label(struct Labeling* lab, int arg){
   return LAB_UNLABELED;
 }
 
+/**
+ * Returns the label of the given argument of a two-valued labeling
+ * (without checking whether the labeling is two-valued).
+ */
+int taas__lab_get_label_twovalued(struct Labeling* lab, int arg){
+  return bitset__get(lab->in,arg) ? LAB_IN : LAB_OUT;
+}
+
 /**
  * Sets the label of the given argument.
  */
@@ -105,7 +113,9 @@ char* taas__lab_print(struct Labeling* lab, struct AAF* aaf){
   int sidx = 0;
   str[sidx++] = '[';
   int isFirst = 1;
-  for(int idx = bitset__next_set_bit(lab->in,0); idx != -1 ; idx = bitset__next_set_bit(lab->in, idx+1)){
+  struct BitSetIterator it;
+  bitset__iterator_init(&it,lab->in);
+  for(int idx = bitset__iterator_next(&it); idx != -1 ; idx = bitset__iterator_next(&it)){
     // if there is also a bit set in lab->out it means the argument is unlabeled, so skip it
     if(!lab->twoValued && bitset__get(lab->out,idx))
       continue;
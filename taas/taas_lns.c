@@ -0,0 +1,211 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_lns.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Large neighbourhood search for the local search: when the walk
+               stagnates, the region around the mislabeled arguments is
+               relabeled exactly (with the CDCL solver) while the labels of
+               all other arguments stay fixed.
+ ============================================================================
+ */
+
+// default radius (in undirected hops around the mislabeled arguments) of a region
+#define LNS_RADIUS 2
+// maximal number of mislabeled arguments for which a region is repaired
+#define LNS_MAX_MISLABELED 64
+// maximal number of arguments of a region
+#define LNS_MAX_REGION 1024
+// a region contains at most the LNS_REGION_DIVISOR-th part of all arguments
+#define LNS_REGION_DIVISOR 2
+// maximal number of conflicts of the CDCL solver for repairing a region
+#define LNS_MAX_CONFLICTS 2000
+
+// the buffers of the large neighbourhood search
+struct Lns{
+  // the arguments of the region; the variable of an argument in the
+  // CDCL solver is its index in region->elements_arr
+  struct RaSet* region;
+  // the arguments outside the region with a neighbour in it
+  struct RaSet* boundary;
+  // a buffer for clauses
+  int* clause;
+  // the maximal number of arguments of a region
+  int max_region;
+  // whether a repair has failed yet, and the fingerprints of the
+  // mislabeled arguments and of the region of the last failed repair
+  int failed;
+  uint64_t failed_mislabeled;
+  uint64_t failed_region;
+};
+
+/**
+ * Initialises the buffers of the large neighbourhood search for the given
+ * AAF; they are released with the arena.
+ */
+struct Lns* taas__lns_init(struct AAF* aaf, struct Arena* arena){
+  struct Lns* lns = arena__alloc(arena, sizeof(struct Lns));
+  lns->region = raset__init_empty_in(aaf->number_of_arguments, arena);
+  lns->boundary = raset__init_empty_in(aaf->number_of_arguments, arena);
+  lns->clause = arena__alloc(arena, (aaf->number_of_arguments + 1) * sizeof(int));
+  lns->max_region = aaf->number_of_arguments / LNS_REGION_DIVISOR;
+  if(lns->max_region > LNS_MAX_REGION)
+    lns->max_region = LNS_MAX_REGION;
+  if(lns->max_region < 1)
+    lns->max_region = 1;
+  lns->failed = FALSE;
+  return lns;
+}
+
+// returns a fingerprint of the given set that does not depend on the
+// order of its elements (the sum of the mixed elements)
+uint64_t __lns__fingerprint(struct RaSet* set){
+  uint64_t fingerprint = set->number_of_elements;
+  for(int i = 0; i < set->number_of_elements; i++){
+    uint64_t z = (uint64_t)raset__get(set,i) * 0x9e3779b97f4a7c15ULL + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    fingerprint += z ^ (z >> 31);
+  }
+  return fingerprint;
+}
+
+// adds the arguments within the given radius around the mislabeled
+// arguments to the region (breadth-first, at most lns->max_region arguments)
+// and their neighbours outside the region to the boundary
+void __lns__grow(struct AAF* aaf, struct Lns* lns, struct RaSet* mislabeled, int radius){
+  struct RaSet* region = lns->region;
+  int max_region = lns->max_region;
+  for(int i = 0; i < mislabeled->number_of_elements && region->number_of_elements < max_region; i++)
+    raset__add(region,raset__get(mislabeled,i));
+  int layer_begin = 0;
+  for(int hop = 0; hop < radius; hop++){
+    int layer_end = region->number_of_elements;
+    for(int i = layer_begin; i < layer_end && region->number_of_elements < max_region; i++){
+      int arg = raset__get(region,i);
+      for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1] && region->number_of_elements < max_region; k++)
+        raset__add(region,aaf->children_arr[k]);
+      for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1] && region->number_of_elements < max_region; k++)
+        raset__add(region,aaf->parents_arr[k]);
+    }
+    layer_begin = layer_end;
+  }
+  for(int i = 0; i < region->number_of_elements; i++){
+    int arg = raset__get(region,i);
+    for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+      if(!raset__contains(region,aaf->children_arr[k]))
+        raset__add(lns->boundary,aaf->children_arr[k]);
+    for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+      if(!raset__contains(region,aaf->parents_arr[k]))
+        raset__add(lns->boundary,aaf->parents_arr[k]);
+  }
+}
+
+/**
+ * Tries to relabel the region of the given radius around the mislabeled
+ * arguments (see __lns__grow()), such that every argument of the region and
+ * every argument of its boundary whose label depends on the region is
+ * labeled correctly, and all arguments outside the region keep their
+ * labels. The search is bounded by LNS_MAX_CONFLICTS conflicts and starts
+ * from the current labels. It is not tried again for the same mislabeled
+ * arguments or the same region as the last failed repair. Returns TRUE iff
+ * the region has been relabeled; then lns->region contains the arguments of
+ * the region (whose neighbours have to be checked again).
+ */
+int taas__lns_repair(struct AAF* aaf, struct BitSet* in, struct RaSet* mislabeled, int radius, struct Lns* lns){
+  uint64_t mislabeled_fingerprint = __lns__fingerprint(mislabeled);
+  if(lns->failed && mislabeled_fingerprint == lns->failed_mislabeled)
+    return FALSE;
+  raset__reset(lns->region);
+  raset__reset(lns->boundary);
+  __lns__grow(aaf,lns,mislabeled,radius);
+  struct RaSet* region = lns->region;
+  uint64_t region_fingerprint = __lns__fingerprint(region);
+  if(lns->failed && region_fingerprint == lns->failed_region){
+    lns->failed_mislabeled = mislabeled_fingerprint;
+    return FALSE;
+  }
+  int* clause = lns->clause;
+  struct CdclSolver solver;
+  cdcl__init(&solver, region->number_of_elements);
+  solver.max_conflicts = LNS_MAX_CONFLICTS;
+  int ok = TRUE;
+  for(int i = 0; i < region->number_of_elements && ok; i++){
+    int arg = raset__get(region,i);
+    cdcl__set_phase(&solver, i, bitset__get(in,arg));
+    // conflict-freeness; arguments attacking or attacked by a fixed
+    // argument in (or themselves) are out
+    int forced_out = bitset__get(aaf->loops,arg);
+    for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1] && ok; k++){
+      int child = aaf->children_arr[k];
+      if(raset__contains(region,child)){
+        if(child != arg){
+          clause[0] = CDCL_LIT(i,FALSE);
+          clause[1] = CDCL_LIT(region->elements_arr_inverted[child],FALSE);
+          ok = cdcl__add_clause(&solver, clause, 2);
+        }
+      }else if(bitset__get(in,child))
+        forced_out = TRUE;
+    }
+    // every argument of the region is in or attacked by an argument in
+    int size = 0;
+    int attacked = FALSE;
+    clause[size++] = CDCL_LIT(i,TRUE);
+    for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++){
+      int parent = aaf->parents_arr[k];
+      if(raset__contains(region,parent)){
+        if(parent != arg)
+          clause[size++] = CDCL_LIT(region->elements_arr_inverted[parent],TRUE);
+      }else if(bitset__get(in,parent))
+        forced_out = attacked = TRUE;
+    }
+    if(ok && !attacked)
+      ok = cdcl__add_clause(&solver, clause, size);
+    if(ok && forced_out){
+      clause[0] = CDCL_LIT(i,FALSE);
+      ok = cdcl__add_clause(&solver, clause, 1);
+    }
+  }
+  // every argument of the boundary that is out and not attacked by a fixed
+  // argument in needs an attacker in within the region (arguments in are
+  // handled by the unit clauses above)
+  for(int i = 0; i < lns->boundary->number_of_elements && ok; i++){
+    int arg = raset__get(lns->boundary,i);
+    if(bitset__get(in,arg))
+      continue;
+    int size = 0;
+    int attacked = FALSE;
+    for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1] && !attacked; k++){
+      int parent = aaf->parents_arr[k];
+      if(raset__contains(region,parent))
+        clause[size++] = CDCL_LIT(region->elements_arr_inverted[parent],TRUE);
+      else if(bitset__get(in,parent))
+        attacked = TRUE;
+    }
+    // if no attacker is in the region, the label does not depend on it
+    if(!attacked && size > 0)
+      ok = cdcl__add_clause(&solver, clause, size);
+  }
+  int result = ok ? cdcl__solve(&solver) : CDCL_UNSAT;
+  if(result == CDCL_SAT)
+    for(int i = 0; i < region->number_of_elements; i++){
+      if(cdcl__value(&solver, i))
+        bitset__set(in,raset__get(region,i));
+      else bitset__unset(in,raset__get(region,i));
+    }
+  cdcl__destroy(&solver);
+  if(result != CDCL_SAT){
+    lns->failed = TRUE;
+    lns->failed_mislabeled = mislabeled_fingerprint;
+    lns->failed_region = region_fingerprint;
+  }
+  return result == CDCL_SAT;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -0,0 +1,196 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_oddcyclefree.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Detection of AAFs without odd cycles (e.g. acyclic or bipartite
+               AAFs) and direct construction of a stable extension for them;
+               such AAFs always have a stable extension.
+ ============================================================================
+ */
+
+/**
+ * Returns TRUE iff the AAF has no (directed) odd cycle. A strongly
+ * connected graph has no odd cycle iff its underlying undirected graph is
+ * bipartite, so every strongly connected component is checked for a
+ * 2-colouring.
+ */
+int taas__aaf_odd_cycle_free(struct AAF* aaf){
+  if(bitset__next_set_bit(aaf->loops,0) != -1)
+    return FALSE;
+  int n = aaf->number_of_arguments;
+  int* component = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  scc__components(aaf,NULL,component);
+  // the colour (0 or 1) of each argument, -1 if not coloured yet
+  char* colour = mem__alloc(n > 0 ? n : 1);
+  int* queue = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  for(int i = 0; i < n; i++)
+    colour[i] = -1;
+  int bipartite = TRUE;
+  for(int start = 0; start < n && bipartite; start++){
+    if(colour[start] != -1)
+      continue;
+    int head = 0, tail = 0;
+    colour[start] = 0;
+    queue[tail++] = start;
+    while(head < tail && bipartite){
+      int arg = queue[head++];
+      for(int dir = 0; dir < 2 && bipartite; dir++){
+        long* idx = dir == 0 ? aaf->children_idx : aaf->parents_idx;
+        int* arr = dir == 0 ? aaf->children_arr : aaf->parents_arr;
+        for(long k = idx[arg]; k < idx[arg+1]; k++){
+          int other = arr[k];
+          if(component[other] != component[arg])
+            continue;
+          if(colour[other] == -1){
+            colour[other] = 1 - colour[arg];
+            queue[tail++] = other;
+          }else if(colour[other] == colour[arg]){
+            bipartite = FALSE;
+            break;
+          }
+        }
+      }
+    }
+  }
+  mem__free(component);
+  mem__free(colour);
+  mem__free(queue);
+  return bipartite;
+}
+
+// labels the argument and propagates the grounded labeling from there on
+// (arguments attacked by an "in" argument are out, arguments all of whose
+// attackers are out are in); "queue" must have room for all arguments
+void __oddcyclefree__label(struct AAF* aaf, int arg, char label, char* labels, long* non_out_attackers, int* queue){
+  int head = 0, tail = 0;
+  labels[arg] = label;
+  queue[tail++] = arg;
+  while(head < tail){
+    int current = queue[head++];
+    for(long k = aaf->children_idx[current]; k < aaf->children_idx[current+1]; k++){
+      int child = aaf->children_arr[k];
+      if(labels[current] == LAB_IN){
+        if(labels[child] == 0){
+          labels[child] = LAB_OUT;
+          queue[tail++] = child;
+        }
+      }else if(--non_out_attackers[child] == 0 && labels[child] == 0){
+        labels[child] = LAB_IN;
+        queue[tail++] = child;
+      }
+    }
+  }
+}
+
+/**
+ * Constructs a stable extension of an AAF without odd cycles and stores it
+ * in "in" (initialised with the number of arguments), starting from the
+ * grounded labeling. The strongly connected components of the undecided
+ * arguments are computed once and taken in topological order; when a
+ * component is taken, all arguments attacking it from outside are labeled
+ * and propagated. Every argument of the component that is still undecided
+ * then has an undecided attacker within the component, and the undecided
+ * arguments of the component are bipartite (as the component is). Labeling
+ * one colour "in" and the other "out" makes every "out" argument attacked by
+ * an "in" one; the labels are propagated to the components downstream.
+ * Returns FALSE if the undecided arguments of some component cannot be
+ * 2-coloured (i.e., the AAF has odd cycles), TRUE otherwise.
+ */
+int taas__odd_cycle_free_stable(struct AAF* aaf, struct Labeling* grounded, struct BitSet* in){
+  int n = aaf->number_of_arguments;
+  char* labels = mem__calloc(n > 0 ? n : 1, sizeof(char));
+  long* non_out_attackers = mem__alloc((n > 0 ? n : 1) * sizeof(long));
+  int* queue = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  int* component = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  // the arguments of each component (grouped by a counting sort)
+  int* members_idx = mem__alloc((n + 2) * sizeof(int));
+  int* members = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  char* colour = mem__alloc(n > 0 ? n : 1);
+  struct BitSet* undecided = malloc(sizeof(struct BitSet));
+  bitset__init(undecided,n);
+  for(int i = 0; i < n; i++)
+    non_out_attackers[i] = aaf->parents_idx[i+1] - aaf->parents_idx[i];
+  for(int i = 0; i < n; i++)
+    if(labels[i] == 0 && bitset__get(grounded->in,i))
+      __oddcyclefree__label(aaf,i,LAB_IN,labels,non_out_attackers,queue);
+  for(int i = 0; i < n; i++)
+    if(labels[i] == 0 && non_out_attackers[i] == 0)
+      __oddcyclefree__label(aaf,i,LAB_IN,labels,non_out_attackers,queue);
+  bitset__unsetAll(undecided);
+  for(int i = 0; i < n; i++)
+    if(labels[i] == 0)
+      bitset__set(undecided,i);
+  int number_of_components = scc__components(aaf,undecided,component);
+  memset(members_idx,0,(number_of_components + 1) * sizeof(int));
+  for(int i = 0; i < n; i++)
+    if(component[i] != -1)
+      members_idx[component[i]+1]++;
+  for(int c = 0; c < number_of_components; c++)
+    members_idx[c+1] += members_idx[c];
+  for(int i = 0; i < n; i++)
+    if(component[i] != -1)
+      members[members_idx[component[i]]++] = i;
+  for(int c = number_of_components; c > 0; c--)
+    members_idx[c] = members_idx[c-1];
+  members_idx[0] = 0;
+  int success = TRUE;
+  // label the components in topological order
+  for(int c = number_of_components - 1; c >= 0 && success; c--){
+    for(int m = members_idx[c]; m < members_idx[c+1]; m++)
+      colour[members[m]] = -1;
+    // 2-colour the arguments of the component that are still undecided
+    for(int m = members_idx[c]; m < members_idx[c+1] && success; m++){
+      int start = members[m];
+      if(labels[start] != 0 || colour[start] != -1)
+        continue;
+      int head = 0, tail = 0;
+      colour[start] = 0;
+      queue[tail++] = start;
+      while(head < tail && success){
+        int arg = queue[head++];
+        for(int dir = 0; dir < 2 && success; dir++){
+          long* idx = dir == 0 ? aaf->children_idx : aaf->parents_idx;
+          int* arr = dir == 0 ? aaf->children_arr : aaf->parents_arr;
+          for(long k = idx[arg]; k < idx[arg+1]; k++){
+            int other = arr[k];
+            if(component[other] != c || labels[other] != 0)
+              continue;
+            if(colour[other] == -1){
+              colour[other] = 1 - colour[arg];
+              queue[tail++] = other;
+            }else if(colour[other] == colour[arg]){
+              success = FALSE;
+              break;
+            }
+          }
+        }
+      }
+    }
+    // the other colour becomes out by propagation
+    for(int m = members_idx[c]; m < members_idx[c+1] && success; m++)
+      if(colour[members[m]] == 0 && labels[members[m]] == 0)
+        __oddcyclefree__label(aaf,members[m],LAB_IN,labels,non_out_attackers,queue);
+  }
+  bitset__unsetAll(in);
+  for(int i = 0; i < n; i++)
+    if(labels[i] == LAB_IN)
+      bitset__set(in,i);
+  bitset__destroy(undecided);
+  mem__free(labels);
+  mem__free(non_out_attackers);
+  mem__free(queue);
+  mem__free(component);
+  mem__free(members_idx);
+  mem__free(members);
+  mem__free(colour);
+  return success;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -0,0 +1,138 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_propagation.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Propagation of labels that hold in every stable labeling (a
+               strengthening of the grounded labeling), computed as a fixpoint
+               with a worklist.
+ ============================================================================
+ */
+
+#define PROPAGATION_OK 1
+#define PROPAGATION_CONTRADICTION 0
+
+// the state of the propagation
+struct Propagation{
+  struct AAF* aaf;
+  // the label of each argument (LAB_IN, LAB_OUT, or 0 if not decided yet)
+  char* labels;
+  // for each argument the number of its attackers not labeled out
+  long* non_out_attackers;
+  // for each argument the number of its attackers labeled in
+  long* in_attackers;
+  // the worklist of arguments whose label has been set but not yet propagated
+  int* queue;
+  int queue_head;
+  int queue_tail;
+};
+
+// labels the argument; returns PROPAGATION_CONTRADICTION if it has the other label
+int __propagation__set(struct Propagation* prop, int arg, char label){
+  if(prop->labels[arg] == label)
+    return PROPAGATION_OK;
+  if(prop->labels[arg] != 0)
+    return PROPAGATION_CONTRADICTION;
+  prop->labels[arg] = label;
+  prop->queue[prop->queue_tail++] = arg;
+  return PROPAGATION_OK;
+}
+
+// applies the rules that depend on the attackers of the argument:
+// - an undecided argument all of whose attackers are out must be in
+// - an argument labeled out needs an attacker labeled in; if there is no
+//   candidate left this is a contradiction, if there is only one candidate
+//   left it must be in
+int __propagation__check(struct Propagation* prop, int arg){
+  struct AAF* aaf = prop->aaf;
+  if(prop->labels[arg] == 0 && prop->non_out_attackers[arg] == 0)
+    return __propagation__set(prop,arg,LAB_IN);
+  if(prop->labels[arg] == LAB_OUT && prop->in_attackers[arg] == 0){
+    if(prop->non_out_attackers[arg] == 0)
+      return PROPAGATION_CONTRADICTION;
+    if(prop->non_out_attackers[arg] == 1){
+      for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+        if(prop->labels[aaf->parents_arr[k]] != LAB_OUT)
+          return __propagation__set(prop,aaf->parents_arr[k],LAB_IN);
+    }
+  }
+  return PROPAGATION_OK;
+}
+
+/**
+ * Extends the given (partial) labeling "lab" (e.g. the grounded labeling) by
+ * all labels that follow from the definition of stable labelings:
+ * - all attackers and attackees of an argument labeled in are out
+ * - self-attacking arguments are out
+ * - an argument all of whose attackers are out is in
+ * - an argument labeled out with exactly one attacker not labeled out has this
+ *   attacker in
+ * Returns PROPAGATION_CONTRADICTION if some argument would have to be both in
+ * and out or an argument labeled out cannot be attacked by an argument
+ * labeled in; then the AAF has no stable extension (extending lab).
+ * Otherwise returns PROPAGATION_OK and every stable labeling extending the
+ * original "lab" also extends the new "lab".
+ */
+int taas__propagate_stable(struct AAF* aaf, struct Labeling* lab){
+  struct Propagation prop;
+  int n = aaf->number_of_arguments;
+  prop.aaf = aaf;
+  prop.labels = mem__calloc(n > 0 ? n : 1, sizeof(char));
+  prop.non_out_attackers = mem__alloc((n > 0 ? n : 1) * sizeof(long));
+  prop.in_attackers = mem__calloc(n > 0 ? n : 1, sizeof(long));
+  prop.queue = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  prop.queue_head = 0;
+  prop.queue_tail = 0;
+  for(int i = 0; i < n; i++)
+    prop.non_out_attackers[i] = aaf->parents_idx[i+1] - aaf->parents_idx[i];
+  int result = PROPAGATION_OK;
+  // the given labels and self-attacking arguments
+  for(int i = 0; i < n && result == PROPAGATION_OK; i++){
+    int label = taas__lab_get_label(lab,i);
+    if(label == LAB_IN || label == LAB_OUT)
+      result = __propagation__set(&prop,i,label);
+  }
+  struct BitSetIterator it;
+  bitset__iterator_init(&it,aaf->loops);
+  for(int arg = bitset__iterator_next(&it); arg != -1 && result == PROPAGATION_OK; arg = bitset__iterator_next(&it))
+    result = __propagation__set(&prop,arg,LAB_OUT);
+  // unattacked arguments
+  for(int i = 0; i < n && result == PROPAGATION_OK; i++)
+    result = __propagation__check(&prop,i);
+  // propagate
+  while(prop.queue_head < prop.queue_tail && result == PROPAGATION_OK){
+    int arg = prop.queue[prop.queue_head++];
+    if(prop.labels[arg] == LAB_IN){
+      for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1] && result == PROPAGATION_OK; k++){
+        prop.in_attackers[aaf->children_arr[k]]++;
+        result = __propagation__set(&prop,aaf->children_arr[k],LAB_OUT);
+      }
+      for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1] && result == PROPAGATION_OK; k++)
+        result = __propagation__set(&prop,aaf->parents_arr[k],LAB_OUT);
+    }else{
+      for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1] && result == PROPAGATION_OK; k++){
+        prop.non_out_attackers[aaf->children_arr[k]]--;
+        result = __propagation__check(&prop,aaf->children_arr[k]);
+      }
+      if(result == PROPAGATION_OK)
+        result = __propagation__check(&prop,arg);
+    }
+  }
+  // write back the labels
+  if(result == PROPAGATION_OK)
+    for(int i = 0; i < prop.queue_tail; i++)
+      taas__lab_set_label(lab,prop.queue[i],prop.labels[prop.queue[i]]);
+  mem__free(prop.labels);
+  mem__free(prop.non_out_attackers);
+  mem__free(prop.in_attackers);
+  mem__free(prop.queue);
+  return result;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -0,0 +1,94 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_refutation.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Linear-time sufficient conditions for the non-existence of a
+               stable extension, checked before the local search.
+ ============================================================================
+ */
+
+#define REFUTATION_NONE 0
+// a self-attacking argument all of whose other attackers are out in the grounded labeling
+#define REFUTATION_SELF_ATTACK 1
+// an odd cycle of undecided arguments that is attacked only by arguments out in the grounded labeling
+#define REFUTATION_ODD_CYCLE 2
+
+// returns a description of the given refutation rule
+const char* taas__refutation_name(int rule){
+  switch(rule){
+    case REFUTATION_SELF_ATTACK: return "self-attacking argument without attackers";
+    case REFUTATION_ODD_CYCLE: return "unattacked odd cycle";
+    default: return "none";
+  }
+}
+
+// returns TRUE iff the argument is out in the grounded labeling
+static inline int __refutation__out(struct Labeling* grounded, int arg){
+  return bitset__get(grounded->out,arg);
+}
+
+/**
+ * Checks some sufficient conditions for the AAF having no stable extension,
+ * given its grounded labeling (all stable labelings extend it); returns the
+ * rule that applies (REFUTATION_SELF_ATTACK or REFUTATION_ODD_CYCLE) or
+ * REFUTATION_NONE if none applies:
+ * - a self-attacking argument must be out, so it needs an attacker other than
+ *   itself that is not out in the grounded labeling;
+ * - a strongly connected component of the undecided arguments in which every
+ *   argument has exactly one attacker not out in the grounded labeling, from
+ *   the same component, is a simple cycle that has to be labeled alternately,
+ *   which is impossible if its length is odd.
+ */
+int taas__refute_stable(struct AAF* aaf, struct Labeling* grounded){
+  struct BitSetIterator it;
+  bitset__iterator_init(&it,aaf->loops);
+  for(int arg = bitset__iterator_next(&it); arg != -1; arg = bitset__iterator_next(&it)){
+    int attacked = FALSE;
+    for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1] && !attacked; k++)
+      if(aaf->parents_arr[k] != arg && !__refutation__out(grounded,aaf->parents_arr[k]))
+        attacked = TRUE;
+    if(!attacked)
+      return REFUTATION_SELF_ATTACK;
+  }
+  int n = aaf->number_of_arguments;
+  struct BitSet* undecided = malloc(sizeof(struct BitSet));
+  bitset__init(undecided,n);
+  bitset__setAll(undecided);
+  bitset__andnot(undecided,grounded->in);
+  bitset__andnot(undecided,grounded->out);
+  int* component = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  int number_of_components = scc__components(aaf,undecided,component);
+  // the size of each component, -1 if the component is not an unattacked cycle
+  int* size = mem__calloc(number_of_components > 0 ? number_of_components : 1, sizeof(int));
+  for(int arg = 0; arg < n; arg++){
+    if(component[arg] == -1 || size[component[arg]] == -1)
+      continue;
+    int attackers = 0;
+    for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1] && attackers <= 1; k++)
+      if(!__refutation__out(grounded,aaf->parents_arr[k])){
+        attackers++;
+        if(component[aaf->parents_arr[k]] != component[arg])
+          attackers = 2;
+      }
+    if(attackers == 1)
+      size[component[arg]]++;
+    else size[component[arg]] = -1;
+  }
+  int result = REFUTATION_NONE;
+  for(int c = 0; c < number_of_components && result == REFUTATION_NONE; c++)
+    if(size[c] > 0 && size[c] % 2 == 1)
+      result = REFUTATION_ODD_CYCLE;
+  mem__free(component);
+  mem__free(size);
+  bitset__destroy(undecided);
+  return result;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
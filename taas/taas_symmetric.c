@@ -0,0 +1,87 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_symmetric.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Direct construction of stable extensions of symmetric AAFs.
+               If every attack is mutual, the stable extensions are exactly
+               the maximal independent sets of the graph without the
+               self-attacking arguments that are adjacent to every
+               self-attacking argument.
+ ============================================================================
+ */
+
+/**
+ * Tries to construct a stable extension of the given symmetric AAF in linear
+ * time and stores it in "in" (initialised with the number of arguments).
+ * Without self-attacking arguments a greedy maximal independent set is
+ * always a stable extension. Otherwise every self-attacking argument first
+ * gets a neighbour in the extension (preferring neighbours adjacent to many
+ * self-attacking arguments) and the extension is then completed greedily;
+ * returns FALSE if this fails for some self-attacking argument (there may
+ * still be a stable extension then), TRUE otherwise.
+ */
+int taas__symmetric_stable(struct AAF* aaf, struct BitSet* in){
+  int n = aaf->number_of_arguments;
+  bitset__unsetAll(in);
+  // arguments that cannot be added anymore (self-attacking or neighbours of "in")
+  struct BitSet* blocked = malloc(sizeof(struct BitSet));
+  bitset__init(blocked,n);
+  bitset__unsetAll(blocked);
+  bitset__union(blocked,aaf->loops);
+  int success = TRUE;
+  if(bitset__next_set_bit(aaf->loops,0) != -1){
+    // the number of self-attacking neighbours of each argument
+    int* loop_neighbours = calloc(n > 0 ? n : 1, sizeof(int));
+    struct BitSetIterator it;
+    bitset__iterator_init(&it,aaf->loops);
+    for(int loop = bitset__iterator_next(&it); loop != -1; loop = bitset__iterator_next(&it))
+      for(long k = aaf->children_idx[loop]; k < aaf->children_idx[loop+1]; k++)
+        loop_neighbours[aaf->children_arr[k]]++;
+    bitset__iterator_init(&it,aaf->loops);
+    for(int loop = bitset__iterator_next(&it); loop != -1 && success; loop = bitset__iterator_next(&it)){
+      // skip the argument if it already has a neighbour in the extension,
+      // otherwise pick the free neighbour with most self-attacking neighbours
+      int best = -1;
+      for(long k = aaf->children_idx[loop]; k < aaf->children_idx[loop+1]; k++){
+        int neighbour = aaf->children_arr[k];
+        if(bitset__get(in,neighbour)){
+          best = -2;
+          break;
+        }
+        if(!bitset__get(blocked,neighbour) && (best == -1 || loop_neighbours[neighbour] > loop_neighbours[best]))
+          best = neighbour;
+      }
+      if(best == -2)
+        continue;
+      if(best == -1){
+        success = FALSE;
+        break;
+      }
+      bitset__set(in,best);
+      bitset__set(blocked,best);
+      for(long k = aaf->children_idx[best]; k < aaf->children_idx[best+1]; k++)
+        bitset__set(blocked,aaf->children_arr[k]);
+    }
+    free(loop_neighbours);
+  }
+  // complete to a maximal independent set
+  for(int i = 0; i < n && success; i++){
+    if(bitset__get(blocked,i))
+      continue;
+    bitset__set(in,i);
+    bitset__set(blocked,i);
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      bitset__set(blocked,aaf->children_arr[k]);
+  }
+  bitset__destroy(blocked);
+  return success;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
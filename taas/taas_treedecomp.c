@@ -0,0 +1,521 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_treedecomp.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Exact search for stable extensions of AAFs of small treewidth:
+               a tree decomposition of the undirected attack graph is obtained
+               from a min-degree elimination ordering and stable extensions
+               are decided by dynamic programming over it.
+ ============================================================================
+ */
+
+// default maximal width of tree decompositions used by the search
+#define TREEDECOMP_MAX_WIDTH 10
+// upper bound for the maximal width (tables are indexed by longs)
+#define TREEDECOMP_WIDTH_LIMIT 18
+// maximal (estimated) number of table operations of the dynamic programming
+#define TREEDECOMP_MAX_WORK 268435456.0
+
+// the labels of the arguments in the tables of the dynamic programming
+#define TREEDECOMP_IN 0
+// out, and attacked by an argument in below the node
+#define TREEDECOMP_OUT_ATTACKED 1
+// out, without any requirement
+#define TREEDECOMP_OUT 2
+
+/**
+ * A tree decomposition given by an elimination ordering: node v of the
+ * tree is the bag consisting of argument v and the neighbours of v at the
+ * time of its elimination (its separator); the parent of v is the argument
+ * of its separator that is eliminated first.
+ */
+struct TreeDecomposition{
+  int number_of_nodes;
+  // the elimination ordering and the position of each argument in it
+  int* order;
+  int* position;
+  // the parent of each node, -1 for roots
+  int* parent;
+  // the separator of node v is bag_arr[bag_idx[v]],...,bag_arr[bag_idx[v+1]-1]
+  long* bag_idx;
+  int* bag_arr;
+  // the children of node v are children_arr[children_idx[v]],...
+  int* children_idx;
+  int* children_arr;
+  // the maximal size of a separator
+  int width;
+};
+
+// a set of undirected edges (open addressing, the key of edge {a,b} with
+// a < b is a * 2^32 + b, which is never 0)
+struct __TreeDecompEdges{
+  uint64_t* keys;
+  long capacity;
+  long size;
+};
+
+static inline long __treedecomp__slot(struct __TreeDecompEdges* edges, uint64_t key){
+  uint64_t h = key * 0x9e3779b97f4a7c15ULL;
+  long slot = (long)((h ^ (h >> 29)) & (uint64_t)(edges->capacity - 1));
+  while(edges->keys[slot] != 0 && edges->keys[slot] != key)
+    slot = (slot + 1) & (edges->capacity - 1);
+  return slot;
+}
+
+// adds the edge {a,b} and returns TRUE iff it has not been contained before
+int __treedecomp__add_edge(struct __TreeDecompEdges* edges, int a, int b){
+  uint64_t key = a < b ? ((uint64_t)a << 32) | (uint64_t)b : ((uint64_t)b << 32) | (uint64_t)a;
+  long slot = __treedecomp__slot(edges,key);
+  if(edges->keys[slot] == key)
+    return FALSE;
+  edges->keys[slot] = key;
+  edges->size++;
+  if(2 * edges->size > edges->capacity){
+    uint64_t* old = edges->keys;
+    long old_capacity = edges->capacity;
+    edges->capacity *= 2;
+    edges->keys = calloc(edges->capacity, sizeof(uint64_t));
+    for(long k = 0; k < old_capacity; k++)
+      if(old[k] != 0)
+        edges->keys[__treedecomp__slot(edges,old[k])] = old[k];
+    free(old);
+  }
+  return TRUE;
+}
+
+// the undirected neighbourhoods during the elimination (including already
+// eliminated arguments, which are skipped)
+struct __TreeDecompGraph{
+  int** adj;
+  int* length;
+  int* capacity;
+  // the number of neighbours not yet eliminated
+  int* degree;
+};
+
+void __treedecomp__append(struct __TreeDecompGraph* graph, int a, int b){
+  if(graph->length[a] == graph->capacity[a]){
+    graph->capacity[a] = graph->capacity[a] > 0 ? 2 * graph->capacity[a] : 4;
+    graph->adj[a] = realloc(graph->adj[a], graph->capacity[a] * sizeof(int));
+  }
+  graph->adj[a][graph->length[a]++] = b;
+  graph->degree[a]++;
+}
+
+void taas__treedecomp_destroy(struct TreeDecomposition* td){
+  free(td->order);
+  free(td->position);
+  free(td->parent);
+  free(td->bag_idx);
+  free(td->bag_arr);
+  free(td->children_idx);
+  free(td->children_arr);
+  free(td);
+}
+
+/**
+ * Computes a tree decomposition of the undirected attack graph of the AAF
+ * (ignoring self-attacks) by eliminating an argument of minimal degree in
+ * each step. Returns NULL as soon as a separator has more than max_width
+ * arguments, or if the estimated work of the dynamic programming of
+ * taas__treedecomp_stable() exceeds TREEDECOMP_MAX_WORK.
+ */
+struct TreeDecomposition* taas__treedecomp(struct AAF* aaf, int max_width){
+  int n = aaf->number_of_arguments;
+  if(max_width > TREEDECOMP_WIDTH_LIMIT)
+    max_width = TREEDECOMP_WIDTH_LIMIT;
+  struct __TreeDecompGraph graph;
+  graph.adj = calloc(n > 0 ? n : 1, sizeof(int*));
+  graph.length = calloc(n > 0 ? n : 1, sizeof(int));
+  graph.capacity = calloc(n > 0 ? n : 1, sizeof(int));
+  graph.degree = calloc(n > 0 ? n : 1, sizeof(int));
+  struct __TreeDecompEdges edges;
+  edges.capacity = 1024;
+  while(edges.capacity < 4 * aaf->number_of_attacks)
+    edges.capacity *= 2;
+  edges.keys = calloc(edges.capacity, sizeof(uint64_t));
+  edges.size = 0;
+  for(int i = 0; i < n; i++){
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      if(aaf->children_arr[k] != i && __treedecomp__add_edge(&edges,i,aaf->children_arr[k])){
+        __treedecomp__append(&graph,i,aaf->children_arr[k]);
+        __treedecomp__append(&graph,aaf->children_arr[k],i);
+      }
+  }
+  struct TreeDecomposition* td = malloc(sizeof(struct TreeDecomposition));
+  td->number_of_nodes = n;
+  td->order = malloc((n > 0 ? n : 1) * sizeof(int));
+  td->position = malloc((n > 0 ? n : 1) * sizeof(int));
+  td->parent = malloc((n > 0 ? n : 1) * sizeof(int));
+  td->bag_idx = malloc((n + 1) * sizeof(long));
+  long bag_capacity = 2 * (long)n + 16;
+  td->bag_arr = malloc(bag_capacity * sizeof(int));
+  td->children_idx = NULL;
+  td->children_arr = NULL;
+  td->width = 0;
+  int* ids = malloc((n > 0 ? n : 1) * sizeof(int));
+  struct BinaryHeap* heap = malloc(sizeof(struct BinaryHeap));
+  binaryheap__init(heap, n > 0 ? n : 1);
+  for(int i = 0; i < n; i++){
+    ids[i] = i;
+    td->position[i] = -1;
+    binaryheap__insert(heap,&ids[i],graph.degree[i]);
+  }
+  int* separator = malloc((max_width + 1) * sizeof(int));
+  int ok = TRUE;
+  td->bag_idx[0] = 0;
+  for(int step = 0; step < n && ok; step++){
+    if(binaryheap__value_of_minimum(heap) > max_width){
+      ok = FALSE;
+      break;
+    }
+    int v = *binaryheap__extract_minimum(heap);
+    td->order[step] = v;
+    td->position[v] = step;
+    int size = 0;
+    for(int k = 0; k < graph.length[v]; k++)
+      if(td->position[graph.adj[v][k]] == -1)
+        separator[size++] = graph.adj[v][k];
+    free(graph.adj[v]);
+    graph.adj[v] = NULL;
+    if(size > td->width)
+      td->width = size;
+    while(td->bag_idx[step] + size > bag_capacity){
+      bag_capacity *= 2;
+      td->bag_arr = realloc(td->bag_arr, bag_capacity * sizeof(int));
+    }
+    for(int k = 0; k < size; k++)
+      td->bag_arr[td->bag_idx[step] + k] = separator[k];
+    td->bag_idx[step+1] = td->bag_idx[step] + size;
+    // the separator becomes a clique
+    for(int k = 0; k < size; k++){
+      graph.degree[separator[k]]--;
+      for(int l = k + 1; l < size; l++)
+        if(__treedecomp__add_edge(&edges,separator[k],separator[l])){
+          __treedecomp__append(&graph,separator[k],separator[l]);
+          __treedecomp__append(&graph,separator[l],separator[k]);
+        }
+    }
+    for(int k = 0; k < size; k++)
+      binaryheap__update(heap,&ids[separator[k]],graph.degree[separator[k]]);
+  }
+  binaryheap__destroy(heap);
+  for(int i = 0; i < n; i++)
+    free(graph.adj[i]);
+  free(graph.adj);
+  free(graph.length);
+  free(graph.capacity);
+  free(graph.degree);
+  free(edges.keys);
+  free(separator);
+  free(ids);
+  if(!ok){
+    taas__treedecomp_destroy(td);
+    return NULL;
+  }
+  // the separators have been stored in elimination order, index them by node
+  long* bag_idx = malloc((n + 1) * sizeof(long));
+  int* bag_arr = malloc((td->bag_idx[n] > 0 ? td->bag_idx[n] : 1) * sizeof(int));
+  bag_idx[0] = 0;
+  for(int v = 0; v < n; v++)
+    bag_idx[v+1] = bag_idx[v] + td->bag_idx[td->position[v]+1] - td->bag_idx[td->position[v]];
+  for(int v = 0; v < n; v++)
+    memcpy(bag_arr + bag_idx[v], td->bag_arr + td->bag_idx[td->position[v]], (bag_idx[v+1] - bag_idx[v]) * sizeof(int));
+  free(td->bag_idx);
+  free(td->bag_arr);
+  td->bag_idx = bag_idx;
+  td->bag_arr = bag_arr;
+  // parents and children
+  td->children_idx = calloc(n + 1, sizeof(int));
+  td->children_arr = malloc((n > 0 ? n : 1) * sizeof(int));
+  for(int v = 0; v < n; v++){
+    td->parent[v] = -1;
+    for(long k = bag_idx[v]; k < bag_idx[v+1]; k++)
+      if(td->parent[v] == -1 || td->position[bag_arr[k]] < td->position[td->parent[v]])
+        td->parent[v] = bag_arr[k];
+    if(td->parent[v] != -1)
+      td->children_idx[td->parent[v]+1]++;
+  }
+  for(int v = 0; v < n; v++)
+    td->children_idx[v+1] += td->children_idx[v];
+  int* next = malloc((n > 0 ? n : 1) * sizeof(int));
+  memcpy(next, td->children_idx, (n > 0 ? n : 1) * sizeof(int));
+  for(int v = 0; v < n; v++)
+    if(td->parent[v] != -1)
+      td->children_arr[next[td->parent[v]]++] = v;
+  free(next);
+  // a node with a bag of b arguments costs about 4^b operations per child
+  double work = 0;
+  for(int v = 0; v < n; v++)
+    work += (td->children_idx[v+1] - td->children_idx[v] + 1) * pow(4, bag_idx[v+1] - bag_idx[v] + 1);
+  if(work > TREEDECOMP_MAX_WORK){
+    taas__treedecomp_destroy(td);
+    return NULL;
+  }
+  return td;
+}
+
+// the state of the dynamic programming of taas__treedecomp_stable()
+struct __TreeDecompSearch{
+  struct AAF* aaf;
+  struct TreeDecomposition* td;
+  // powers of 3
+  long* pow3;
+  // tables[v][s] is TRUE iff the labeling s of the separator of v (base 3,
+  // the i-th argument of the separator is the i-th digit) can be extended
+  // to the arguments below v (in the subtree of v), such that all of them
+  // are labeled correctly and every argument of the separator labeled
+  // TREEDECOMP_OUT_ATTACKED is attacked by an argument in below v
+  char** tables;
+  // for the node being processed: whether v attacks / is attacked by the
+  // i-th argument of its separator
+  int* attacks;
+  int* attacked_by;
+  // the position of the arguments of the separator of a child in the bag
+  // of its parent
+  int* positions;
+  // marks (indexed by arguments) used for computing the above
+  int* mark;
+  int* mark_parents;
+};
+
+// the digit of s at position i
+static inline int __treedecomp__digit(struct __TreeDecompSearch* search, long s, int i){
+  return (int)((s / search->pow3[i]) % 3);
+}
+
+// computes the positions of the separator of child c within the bag of
+// its parent v (argument v at position 0, the i-th argument of the
+// separator of v at position i+1)
+void __treedecomp__positions(struct __TreeDecompSearch* search, int v, int c){
+  struct TreeDecomposition* td = search->td;
+  for(long k = td->bag_idx[c]; k < td->bag_idx[c+1]; k++){
+    int arg = td->bag_arr[k];
+    int pos = 0;
+    if(arg != v)
+      for(long l = td->bag_idx[v]; l < td->bag_idx[v+1]; l++)
+        if(td->bag_arr[l] == arg)
+          pos = (int)(l - td->bag_idx[v]) + 1;
+    search->positions[k - td->bag_idx[c]] = pos;
+  }
+}
+
+// returns the index of the labeling of child c's separator induced by the
+// labeling "bag" of its parent's bag, where exactly the arguments labeled
+// TREEDECOMP_OUT_ATTACKED at the positions "covered" (a mask over the
+// separator of c) stay TREEDECOMP_OUT_ATTACKED; the positions of the
+// separator must have been computed by __treedecomp__positions()
+long __treedecomp__child_index(struct __TreeDecompSearch* search, int c, long bag, long covered){
+  struct TreeDecomposition* td = search->td;
+  int size = (int)(td->bag_idx[c+1] - td->bag_idx[c]);
+  long index = 0;
+  for(int i = 0; i < size; i++){
+    int digit = __treedecomp__digit(search,bag,search->positions[i]);
+    if(digit == TREEDECOMP_OUT_ATTACKED && !(covered & (1L << i)))
+      digit = TREEDECOMP_OUT;
+    index += digit * search->pow3[i];
+  }
+  return index;
+}
+
+// returns the mask of the positions of the separator of child c labeled
+// TREEDECOMP_OUT_ATTACKED in the labeling "bag" of its parent's bag
+long __treedecomp__attacked_mask(struct __TreeDecompSearch* search, int c, long bag){
+  struct TreeDecomposition* td = search->td;
+  int size = (int)(td->bag_idx[c+1] - td->bag_idx[c]);
+  long mask = 0;
+  for(int i = 0; i < size; i++)
+    if(__treedecomp__digit(search,bag,search->positions[i]) == TREEDECOMP_OUT_ATTACKED)
+      mask |= 1L << i;
+  return mask;
+}
+
+// returns the labeling "bag" where the arguments labeled
+// TREEDECOMP_OUT_ATTACKED at the positions "covered" (a mask over the
+// separator of the child whose positions have been computed last by
+// __treedecomp__positions()) are relabeled TREEDECOMP_OUT
+long __treedecomp__uncover(struct __TreeDecompSearch* search, long bag, long covered){
+  for(int i = 0; covered != 0; i++, covered >>= 1)
+    if(covered & 1)
+      bag += search->pow3[search->positions[i]];
+  return bag;
+}
+
+// computes the tables joins[0],...,joins[k] over the bag of v (k being the
+// number of children of v): joins[j][b] is TRUE iff the labeling b of the
+// bag can be extended to the arguments below the first j children of v,
+// such that all of them are labeled correctly and every argument of the bag
+// labeled TREEDECOMP_OUT_ATTACKED is attacked by one of them that is in
+void __treedecomp__join(struct __TreeDecompSearch* search, int v, char** joins){
+  struct TreeDecomposition* td = search->td;
+  long size = search->pow3[td->bag_idx[v+1] - td->bag_idx[v] + 1];
+  int number_of_children = td->children_idx[v+1] - td->children_idx[v];
+  int bag_size = (int)(td->bag_idx[v+1] - td->bag_idx[v]) + 1;
+  joins[0] = malloc(size);
+  for(long b = 0; b < size; b++){
+    joins[0][b] = TRUE;
+    for(int i = 0; i < bag_size && joins[0][b]; i++)
+      if(__treedecomp__digit(search,b,i) == TREEDECOMP_OUT_ATTACKED)
+        joins[0][b] = FALSE;
+  }
+  for(int j = 0; j < number_of_children; j++){
+    int c = td->children_arr[td->children_idx[v] + j];
+    __treedecomp__positions(search,v,c);
+    char* table = search->tables[c];
+    joins[j+1] = malloc(size);
+    for(long b = 0; b < size; b++){
+      // the child covers a subset of the arguments of its separator labeled
+      // TREEDECOMP_OUT_ATTACKED, the previous children cover the others
+      long attacked = __treedecomp__attacked_mask(search,c,b);
+      char value = FALSE;
+      for(long covered = attacked; !value; covered = (covered - 1) & attacked){
+        value = joins[j][__treedecomp__uncover(search,b,covered)] && table[__treedecomp__child_index(search,c,b,covered)];
+        if(covered == 0)
+          break;
+      }
+      joins[j+1][b] = value;
+    }
+  }
+}
+
+// returns the index in the tables of __treedecomp__join() for node v
+// labeled "label" (TREEDECOMP_IN or TREEDECOMP_OUT_ATTACKED) and its
+// separator labeled s, or -1 if this labeling is not conflict-free; the
+// arrays "attacks" and "attacked_by" must have been computed for v
+long __treedecomp__forget(struct __TreeDecompSearch* search, int v, long s, int label){
+  int size = (int)(search->td->bag_idx[v+1] - search->td->bag_idx[v]);
+  if(label == TREEDECOMP_IN){
+    if(bitset__get(search->aaf->loops,v))
+      return -1;
+    long bag = s;
+    for(int i = 0; i < size; i++){
+      int digit = __treedecomp__digit(search,s,i);
+      if(digit == TREEDECOMP_IN && (search->attacks[i] || search->attacked_by[i]))
+        return -1;
+      // arguments attacked by v need not be attacked from below
+      if(digit == TREEDECOMP_OUT_ATTACKED && search->attacks[i])
+        bag += search->pow3[i];
+    }
+    return 3 * bag + TREEDECOMP_IN;
+  }
+  for(int i = 0; i < size; i++)
+    if(search->attacked_by[i] && __treedecomp__digit(search,s,i) == TREEDECOMP_IN)
+      return 3 * s + TREEDECOMP_OUT;
+  return 3 * s + TREEDECOMP_OUT_ATTACKED;
+}
+
+// computes whether v attacks / is attacked by the arguments of its separator
+void __treedecomp__neighbours(struct __TreeDecompSearch* search, int v){
+  struct AAF* aaf = search->aaf;
+  struct TreeDecomposition* td = search->td;
+  for(long k = aaf->children_idx[v]; k < aaf->children_idx[v+1]; k++)
+    search->mark[aaf->children_arr[k]] = v + 1;
+  for(long k = aaf->parents_idx[v]; k < aaf->parents_idx[v+1]; k++)
+    search->mark_parents[aaf->parents_arr[k]] = v + 1;
+  for(long k = td->bag_idx[v]; k < td->bag_idx[v+1]; k++){
+    search->attacks[k - td->bag_idx[v]] = search->mark[td->bag_arr[k]] == v + 1;
+    search->attacked_by[k - td->bag_idx[v]] = search->mark_parents[td->bag_arr[k]] == v + 1;
+  }
+}
+
+/**
+ * Decides whether the given AAF has a stable extension by dynamic
+ * programming over the given tree decomposition (see taas__treedecomp())
+ * and stores it in "in" (initialised with the number of arguments) if so;
+ * returns TRUE iff there is a stable extension. The answer is exact.
+ */
+int taas__treedecomp_stable(struct AAF* aaf, struct TreeDecomposition* td, struct BitSet* in){
+  int n = aaf->number_of_arguments;
+  struct __TreeDecompSearch search;
+  search.aaf = aaf;
+  search.td = td;
+  search.pow3 = malloc((td->width + 2) * sizeof(long));
+  search.pow3[0] = 1;
+  for(int i = 1; i < td->width + 2; i++)
+    search.pow3[i] = 3 * search.pow3[i-1];
+  search.tables = calloc(n > 0 ? n : 1, sizeof(char*));
+  search.attacks = malloc((td->width + 1) * sizeof(int));
+  search.attacked_by = malloc((td->width + 1) * sizeof(int));
+  search.positions = malloc((td->width + 1) * sizeof(int));
+  search.mark = calloc(n > 0 ? n : 1, sizeof(int));
+  search.mark_parents = calloc(n > 0 ? n : 1, sizeof(int));
+  int max_children = 0;
+  for(int v = 0; v < n; v++)
+    if(td->children_idx[v+1] - td->children_idx[v] > max_children)
+      max_children = td->children_idx[v+1] - td->children_idx[v];
+  char** joins = malloc((max_children + 1) * sizeof(char*));
+  // bottom-up: children are eliminated before their parents
+  int found = TRUE;
+  for(int step = 0; step < n && found; step++){
+    int v = td->order[step];
+    int number_of_children = td->children_idx[v+1] - td->children_idx[v];
+    __treedecomp__join(&search,v,joins);
+    __treedecomp__neighbours(&search,v);
+    long size = search.pow3[td->bag_idx[v+1] - td->bag_idx[v]];
+    search.tables[v] = malloc(size);
+    for(long s = 0; s < size; s++){
+      long in_index = __treedecomp__forget(&search,v,s,TREEDECOMP_IN);
+      long out_index = __treedecomp__forget(&search,v,s,TREEDECOMP_OUT_ATTACKED);
+      search.tables[v][s] = (in_index != -1 && joins[number_of_children][in_index]) || joins[number_of_children][out_index];
+    }
+    for(int j = 0; j <= number_of_children; j++)
+      free(joins[j]);
+    // every root must have a solution
+    if(td->parent[v] == -1)
+      found = search.tables[v][0];
+  }
+  // top-down: label each node consistently with the labeling of its
+  // separator chosen by its parent and choose the labelings of the
+  // separators of its children
+  if(found){
+    bitset__unsetAll(in);
+    long* chosen = calloc(n > 0 ? n : 1, sizeof(long));
+    for(int step = n - 1; step >= 0; step--){
+      int v = td->order[step];
+      int number_of_children = td->children_idx[v+1] - td->children_idx[v];
+      __treedecomp__join(&search,v,joins);
+      __treedecomp__neighbours(&search,v);
+      long bag = __treedecomp__forget(&search,v,chosen[v],TREEDECOMP_IN);
+      if(bag != -1 && joins[number_of_children][bag])
+        bitset__set(in,v);
+      else bag = __treedecomp__forget(&search,v,chosen[v],TREEDECOMP_OUT_ATTACKED);
+      for(int j = number_of_children - 1; j >= 0; j--){
+        int c = td->children_arr[td->children_idx[v] + j];
+        __treedecomp__positions(&search,v,c);
+        long attacked = __treedecomp__attacked_mask(&search,c,bag);
+        for(long covered = attacked; ; covered = (covered - 1) & attacked){
+          long child = __treedecomp__child_index(&search,c,bag,covered);
+          long rest = __treedecomp__uncover(&search,bag,covered);
+          if((joins[j][rest] && search.tables[c][child]) || covered == 0){
+            chosen[c] = child;
+            bag = rest;
+            break;
+          }
+        }
+      }
+      for(int j = 0; j <= number_of_children; j++)
+        free(joins[j]);
+    }
+    free(chosen);
+  }
+  for(int v = 0; v < n; v++)
+    free(search.tables[v]);
+  free(search.tables);
+  free(joins);
+  free(search.pow3);
+  free(search.attacks);
+  free(search.attacked_by);
+  free(search.positions);
+  free(search.mark);
+  free(search.mark_parents);
+  return found;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -0,0 +1,122 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_twins.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Detection of twins, i.e., arguments with the same attackers and
+               the same attackees. Twins have the same label in every stable
+               labeling (twins attacking each other are self-attacking and
+               hence out), so all but one argument of each class of twins
+               can be removed before the search.
+ ============================================================================
+ */
+
+// an argument together with the hash value of its neighbourhood
+struct TwinKey{
+  uint64_t hash;
+  int arg;
+};
+
+int __twins__compare(const void* a, const void* b){
+  const struct TwinKey* x = a;
+  const struct TwinKey* y = b;
+  if(x->hash != y->hash)
+    return x->hash < y->hash ? -1 : 1;
+  return x->arg - y->arg;
+}
+
+// a hash value of the given argument that does not depend on the order of
+// the neighbours (splitmix64 finaliser)
+static inline uint64_t __twins__mix(uint64_t x){
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// returns TRUE iff the given neighbourhoods are the same set; "stamp" must
+// not contain the value "mark" before
+int __twins__same_neighbours(int* arr, long from1, long to1, long from2, long to2, int* stamp, int mark){
+  if(to1 - from1 != to2 - from2)
+    return FALSE;
+  for(long k = from1; k < to1; k++)
+    stamp[arr[k]] = mark;
+  for(long k = from2; k < to2; k++)
+    if(stamp[arr[k]] != mark)
+      return FALSE;
+  return TRUE;
+}
+
+/**
+ * Computes the classes of twins of the AAF: afterwards twin_of[i] (an array
+ * of length number_of_arguments) is the smallest argument with the same
+ * parents and children as i, and "representatives" (initialised with the
+ * number of arguments) contains the arguments i with twin_of[i] == i.
+ * Neighbourhoods are hashed and only arguments with equal hash values are
+ * compared. Returns the number of representatives.
+ */
+int taas__twins(struct AAF* aaf, int* twin_of, struct BitSet* representatives){
+  int n = aaf->number_of_arguments;
+  struct TwinKey* keys = malloc((n > 0 ? n : 1) * sizeof(struct TwinKey));
+  for(int i = 0; i < n; i++){
+    uint64_t hash = 0;
+    for(long k = aaf->parents_idx[i]; k < aaf->parents_idx[i+1]; k++)
+      hash += __twins__mix(2 * (uint64_t)aaf->parents_arr[k]);
+    for(long k = aaf->children_idx[i]; k < aaf->children_idx[i+1]; k++)
+      hash += __twins__mix(2 * (uint64_t)aaf->children_arr[k] + 1);
+    keys[i].hash = hash;
+    keys[i].arg = i;
+  }
+  qsort(keys,n,sizeof(struct TwinKey),__twins__compare);
+  int* stamp = calloc(n > 0 ? n : 1, sizeof(int));
+  int mark = 0;
+  bitset__unsetAll(representatives);
+  int number_of_representatives = 0;
+  for(int first = 0; first < n; ){
+    int last = first + 1;
+    while(last < n && keys[last].hash == keys[first].hash)
+      last++;
+    // within a group of equal hash values, compare every argument with the
+    // representatives found so far (groups are almost always small)
+    for(int m = first; m < last; m++){
+      int arg = keys[m].arg;
+      twin_of[arg] = arg;
+      for(int r = first; r < m; r++){
+        int rep = keys[r].arg;
+        if(twin_of[rep] != rep)
+          continue;
+        if(__twins__same_neighbours(aaf->parents_arr,aaf->parents_idx[rep],aaf->parents_idx[rep+1],aaf->parents_idx[arg],aaf->parents_idx[arg+1],stamp,++mark) &&
+            __twins__same_neighbours(aaf->children_arr,aaf->children_idx[rep],aaf->children_idx[rep+1],aaf->children_idx[arg],aaf->children_idx[arg+1],stamp,++mark)){
+          twin_of[arg] = rep;
+          break;
+        }
+      }
+      if(twin_of[arg] == arg){
+        bitset__set(representatives,arg);
+        number_of_representatives++;
+      }
+    }
+    first = last;
+  }
+  free(stamp);
+  free(keys);
+  return number_of_representatives;
+}
+
+/**
+ * Adds every argument whose representative (see taas__twins()) is in "in"
+ * to "in".
+ */
+void taas__twins_expand(struct AAF* aaf, int* twin_of, struct BitSet* in){
+  for(int i = 0; i < aaf->number_of_arguments; i++)
+    if(twin_of[i] != i && bitset__get(in,twin_of[i]))
+      bitset__set(in,i);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
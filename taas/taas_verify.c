@@ -0,0 +1,169 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : taas_verify.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Bulk verification of two-valued labelings: the sets of arguments
+               attacked by and attacking an "in" argument are computed in one
+               sweep over the adjacency (optionally in several threads) and
+               compared word-wise with the set of "in" arguments.
+ ============================================================================
+ */
+
+// minimal number of arguments per thread; for smaller AAFs fewer threads are used
+#define VERIFY_MIN_ARGUMENTS_PER_THREAD 16384
+
+// the part of the sweep done by one thread
+struct VerifyTask{
+  struct AAF* aaf;
+  struct BitSet* in;
+  struct BitSet* attacked;
+  struct BitSet* attacking;
+  // the words of "attacked" and "attacking" computed by this task
+  int first_word;
+  int last_word;
+};
+
+// returns TRUE iff some argument in "in" is among the given arguments
+static inline int __taas__any_in(struct BitSet* in, int* arr, long from, long to){
+  for(long k = from; k < to; k++)
+    if(bitset__get(in,arr[k]))
+      return TRUE;
+  return FALSE;
+}
+
+// computes the words first_word,...,last_word-1 of the set of arguments that
+// have a parent in "in" (and of the set of arguments that have a child in "in",
+// if "attacking" is not NULL) by checking the neighbours of every argument
+void __taas__compute_attacked_range(struct AAF* aaf, struct BitSet* in, struct BitSet* attacked, struct BitSet* attacking, int first_word, int last_word){
+  for(int w = first_word; w < last_word; w++){
+    uint64_t attacked_word = 0, attacking_word = 0;
+    int first = w * WORD_BITS;
+    int last = first + WORD_BITS < aaf->number_of_arguments ? first + WORD_BITS : aaf->number_of_arguments;
+    for(int arg = first; arg < last; arg++){
+      if(aaf->dense ? bitmatrix__rows_intersect(aaf->parents_matrix,NULL,arg,in) :
+          __taas__any_in(in,aaf->parents_arr,aaf->parents_idx[arg],aaf->parents_idx[arg+1]))
+        attacked_word |= 1ULL << (arg - first);
+      if(attacking != NULL && (aaf->dense ? bitmatrix__rows_intersect(aaf->children_matrix,NULL,arg,in) :
+          __taas__any_in(in,aaf->children_arr,aaf->children_idx[arg],aaf->children_idx[arg+1])))
+        attacking_word |= 1ULL << (arg - first);
+    }
+    attacked->data[w] = attacked_word;
+    if(attacking != NULL)
+      attacking->data[w] = attacking_word;
+  }
+}
+
+void* __taas__compute_attacked_worker(void* arg){
+  struct VerifyTask* task = arg;
+  __taas__compute_attacked_range(task->aaf,task->in,task->attacked,task->attacking,task->first_word,task->last_word);
+  return NULL;
+}
+
+/**
+ * Computes the set "attacked" of arguments that are attacked by some argument
+ * in "in" and, if "attacking" is not NULL, the set "attacking" of arguments
+ * that attack some argument in "in" (both must be initialised with the number
+ * of arguments). With one thread the "in" arguments are pushed to their
+ * neighbours; with more threads every thread checks the neighbours of a range
+ * of arguments.
+ */
+void taas__compute_attacked(struct AAF* aaf, struct BitSet* in, struct BitSet* attacked, struct BitSet* attacking, int threads){
+  if(threads > aaf->number_of_arguments / VERIFY_MIN_ARGUMENTS_PER_THREAD)
+    threads = aaf->number_of_arguments / VERIFY_MIN_ARGUMENTS_PER_THREAD;
+  if(threads <= 1){
+    bitset__unsetAll(attacked);
+    if(attacking != NULL)
+      bitset__unsetAll(attacking);
+    struct BitSetIterator it;
+    bitset__iterator_init(&it,in);
+    for(int arg = bitset__iterator_next(&it); arg != -1; arg = bitset__iterator_next(&it)){
+      if(aaf->dense){
+        bitmatrix__row_or(aaf->children_matrix,arg,attacked);
+        if(attacking != NULL)
+          bitmatrix__row_or(aaf->parents_matrix,arg,attacking);
+      }else{
+        for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+          bitset__set(attacked,aaf->children_arr[k]);
+        if(attacking != NULL)
+          for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+            bitset__set(attacking,aaf->parents_arr[k]);
+      }
+    }
+    return;
+  }
+  pthread_t* workers = malloc(threads * sizeof(pthread_t));
+  struct VerifyTask* tasks = malloc(threads * sizeof(struct VerifyTask));
+  int words_per_thread = (attacked->num_elements + threads - 1) / threads;
+  for(int t = 0; t < threads; t++){
+    tasks[t].aaf = aaf;
+    tasks[t].in = in;
+    tasks[t].attacked = attacked;
+    tasks[t].attacking = attacking;
+    tasks[t].first_word = t * words_per_thread < attacked->num_elements ? t * words_per_thread : attacked->num_elements;
+    tasks[t].last_word = tasks[t].first_word + words_per_thread < attacked->num_elements ? tasks[t].first_word + words_per_thread : attacked->num_elements;
+    if(pthread_create(&workers[t],NULL,__taas__compute_attacked_worker,&tasks[t]) != 0){
+      // no more threads available, do the rest here
+      __taas__compute_attacked_range(aaf,in,attacked,attacking,tasks[t].first_word,attacked->num_elements);
+      threads = t;
+      break;
+    }
+  }
+  for(int t = 0; t < threads; t++)
+    pthread_join(workers[t],NULL);
+  free(workers);
+  free(tasks);
+}
+
+/**
+ * Adds all arguments not in "fixed" (if not NULL) that are mislabeled in the
+ * two-valued labeling given by "in" to the set "mislabeled", in ascending
+ * order (this gives the same set as taas__labeled_correctly() for every
+ * argument): an argument is mislabeled iff it is "in" and conflicts with an
+ * "in" neighbour or it is "out" and not attacked by an "in" argument.
+ * "attacked" and "attacking" are used as buffers.
+ */
+void taas__compute_mislabeled(struct AAF* aaf, struct BitSet* in, struct BitSet* fixed, struct BitSet* attacked, struct BitSet* attacking, struct RaSet* mislabeled, int threads){
+  taas__compute_attacked(aaf,in,attacked,attacking,threads);
+  for(int w = 0; w < in->num_elements; w++){
+    uint64_t wrong = (in->data[w] & (attacked->data[w] | attacking->data[w])) | ~(in->data[w] | attacked->data[w]);
+    if(fixed != NULL)
+      wrong &= ~fixed->data[w];
+    if(w == in->num_elements - 1)
+      wrong &= (1ULL << (in->length % WORD_BITS)) - 1;
+    while(wrong != 0){
+      raset__add(mislabeled, w * WORD_BITS + __builtin_ctzll(wrong));
+      wrong &= wrong - 1;
+    }
+  }
+}
+
+/**
+ * Returns TRUE iff the set "in" is a stable extension of the AAF, i.e. iff
+ * exactly the arguments not in "in" are attacked by "in" (which implies that
+ * "in" is conflict-free); this check is independent of the data structures of
+ * the search and is used as a certificate check before an extension is printed.
+ */
+int taas__verify_stable(struct AAF* aaf, struct BitSet* in, int threads){
+  struct BitSet* attacked = malloc(sizeof(struct BitSet));
+  bitset__init(attacked,aaf->number_of_arguments);
+  taas__compute_attacked(aaf,in,attacked,NULL,threads);
+  int stable = TRUE;
+  for(int w = 0; w < in->num_elements && stable; w++){
+    uint64_t wrong = ~(in->data[w] ^ attacked->data[w]);
+    if(w == in->num_elements - 1)
+      wrong &= (1ULL << (in->length % WORD_BITS)) - 1;
+    if(wrong != 0)
+      stable = FALSE;
+  }
+  bitset__destroy(attacked);
+  return stable;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
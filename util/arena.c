@@ -0,0 +1,99 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : arena.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A region allocator: objects are allocated by bumping a pointer
+               in large chunks and are all released at once when the arena is
+               destroyed (e.g. at the end of a phase of the solver).
+ ============================================================================
+ */
+
+// size of the first chunk of an arena (in bytes)
+#define ARENA_MIN_CHUNK_SIZE (64*1024)
+// chunks grow geometrically up to this size (in bytes)
+#define ARENA_MAX_CHUNK_SIZE (64*1024*1024)
+// alignment of all allocations (in bytes)
+#define ARENA_ALIGNMENT 16
+
+/* A chunk of an arena; the memory of the chunk follows this header */
+struct ArenaChunk{
+  struct ArenaChunk* next;
+  // the size of the memory (without this header)
+  size_t size;
+  // the number of bytes already used
+  size_t used;
+  // padding so that the memory is aligned
+  size_t padding;
+};
+
+/* An arena */
+struct Arena{
+  // the chunk allocations are served from (first element of a list of all chunks)
+  struct ArenaChunk* current;
+  // the size of the next chunk
+  size_t next_chunk_size;
+};
+
+/** initialises and returns a new (empty) arena */
+struct Arena* arena__init(){
+  struct Arena* arena = malloc(sizeof(struct Arena));
+  arena->current = NULL;
+  arena->next_chunk_size = ARENA_MIN_CHUNK_SIZE;
+  return arena;
+}
+
+/** allocates memory of the given size from the arena */
+void* arena__alloc(struct Arena* arena, size_t size){
+  size = (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+  if(arena->current == NULL || arena->current->used + size > arena->current->size){
+    // chunks (including all headers) fill whole (huge) pages
+    size_t chunk_size = arena->next_chunk_size - MEM_HEADER_SIZE - sizeof(struct ArenaChunk);
+    if(chunk_size < size)
+      chunk_size = size;
+    struct ArenaChunk* chunk = mem__alloc(sizeof(struct ArenaChunk) + chunk_size);
+    chunk->size = chunk_size;
+    chunk->used = 0;
+    chunk->next = arena->current;
+    arena->current = chunk;
+    if(arena->next_chunk_size < ARENA_MAX_CHUNK_SIZE)
+      arena->next_chunk_size *= 2;
+  }
+  void* ptr = (char*)arena->current + sizeof(struct ArenaChunk) + arena->current->used;
+  arena->current->used += size;
+  return ptr;
+}
+
+/** allocates zero-initialised memory of the given size from the arena */
+void* arena__calloc(struct Arena* arena, size_t size){
+  void* ptr = arena__alloc(arena, size);
+  memset(ptr, 0, size);
+  return ptr;
+}
+
+/** copies the given string into the arena */
+char* arena__strdup(struct Arena* arena, char* str){
+  size_t len = strlen(str);
+  char* copy = arena__alloc(arena, len+1);
+  memcpy(copy, str, len+1);
+  return copy;
+}
+
+/** releases all memory allocated from the arena and the arena itself */
+void arena__destroy(struct Arena* arena){
+  struct ArenaChunk* chunk = arena->current;
+  while(chunk != NULL){
+    struct ArenaChunk* next = chunk->next;
+    mem__free(chunk);
+    chunk = next;
+  }
+  free(arena);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -89,6 +89,14 @@ int binaryheap__value_of_minimum(struct BinaryHeap* heap){
   return heap->values[*heap->data[0]];
 }
 
+/**
+ * Returns the value of the given argument (which must be contained).
+ * @return
+ */
+int binaryheap__value_of(struct BinaryHeap* heap, int* arg){
+  return heap->values[*arg];
+}
+
 /* ============================================================================================================== */
 /* ============================================================================================================== */
 
@@ -233,9 +241,23 @@ void binaryheap__update(struct BinaryHeap* heap, int* arg, int value){
 /* ============================================================================================================== */
 /* ============================================================================================================== */
 
+/**
+ * Removes all elements from the heap (in time linear in the number of
+ * elements), so that the heap can be reused without reallocation.
+ */
+void binaryheap__reset(struct BinaryHeap* heap){
+	for(int i = 0; i < heap->length; i++)
+		bitset__unset(heap->elements, *heap->data[i]);
+	heap->length = 0;
+}
+
+/* ============================================================================================================== */
+/* ============================================================================================================== */
+
 void binaryheap__destroy(struct BinaryHeap* heap){
 	free(heap->values);
   free(heap->data);
+  free(heap->inv_index);
 	bitset__destroy(heap->elements);
 	free(heap);
 }
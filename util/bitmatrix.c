@@ -0,0 +1,185 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : bitmatrix.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A square bit matrix (e.g. the adjacency matrix of a graph) with
+               row kernels that combine a row with a bitset word-wide.
+ ============================================================================
+ */
+
+// rows are padded to a multiple of this many words so that
+// vectorised kernels never need a scalar prologue
+#define BITMATRIX_ROW_ALIGN 4
+
+/* A bit matrix structure */
+struct BitMatrix{
+  uint64_t* data;
+  // number of rows
+  int rows;
+  // number of columns (bits per row)
+  int columns;
+  // number of words per row
+  int row_elements;
+};
+
+/** Init bit matrix, all bits are initially zero. */
+void bitmatrix__init(struct BitMatrix* matrix, int rows, int columns){
+  matrix->rows = rows;
+  matrix->columns = columns;
+  matrix->row_elements = ((columns/WORD_BITS)+1);
+  matrix->row_elements = ((matrix->row_elements + BITMATRIX_ROW_ALIGN - 1)/BITMATRIX_ROW_ALIGN) * BITMATRIX_ROW_ALIGN;
+  matrix->data = mem__calloc((size_t)matrix->rows * matrix->row_elements, sizeof(uint64_t));
+}
+
+/** returns the data of the given row */
+uint64_t* bitmatrix__row(struct BitMatrix* matrix, int row){
+  return &matrix->data[(size_t)row * matrix->row_elements];
+}
+
+/** set a value in a bit matrix **/
+void bitmatrix__set(struct BitMatrix* matrix, int row, int column){
+  bitmatrix__row(matrix,row)[column / WORD_BITS] |= (1ULL << (column % WORD_BITS));
+}
+
+/** get value of a bit in a bit matrix **/
+int bitmatrix__get(struct BitMatrix* matrix, int row, int column){
+  return (bitmatrix__row(matrix,row)[column / WORD_BITS] & (1ULL << (column % WORD_BITS))) != 0;
+}
+
+// the row kernels combine the words r1 (OR r2 if not NULL) with the words b
+// (n words each); scalar variants
+int __bitmatrix__intersect_scalar(uint64_t* r1, uint64_t* r2, uint64_t* b, int n){
+  if(r2 != NULL){
+    for(int i = 0; i < n; i++)
+      if((r1[i] | r2[i]) & b[i])
+        return TRUE;
+  }else{
+    for(int i = 0; i < n; i++)
+      if(r1[i] & b[i])
+        return TRUE;
+  }
+  return FALSE;
+}
+
+int __bitmatrix__and_count_scalar(uint64_t* r1, uint64_t* r2, uint64_t* b, int n){
+  int count = 0;
+  if(r2 != NULL){
+    for(int i = 0; i < n; i++)
+      count += __builtin_popcountll((r1[i] | r2[i]) & b[i]);
+  }else{
+    for(int i = 0; i < n; i++)
+      count += __builtin_popcountll(r1[i] & b[i]);
+  }
+  return count;
+}
+
+// b = b OR r1
+void __bitmatrix__or_scalar(uint64_t* r1, uint64_t* b, int n){
+  for(int i = 0; i < n; i++)
+    b[i] |= r1[i];
+}
+
+#ifdef BITSET_AVX2_DISPATCH
+// AVX2 variants of the row kernels (the remaining words are left to the
+// scalar variants)
+__attribute__((target("avx2")))
+int __bitmatrix__intersect_avx2(uint64_t* r1, uint64_t* r2, uint64_t* b, int n){
+  int i = 0;
+  for(; i + 4 <= n; i += 4){
+    __m256i a = _mm256_loadu_si256((__m256i*)&r1[i]);
+    if(r2 != NULL)
+      a = _mm256_or_si256(a,_mm256_loadu_si256((__m256i*)&r2[i]));
+    if(!_mm256_testz_si256(a,_mm256_loadu_si256((__m256i*)&b[i])))
+      return TRUE;
+  }
+  return __bitmatrix__intersect_scalar(&r1[i], r2 != NULL ? &r2[i] : NULL, &b[i], n-i);
+}
+
+__attribute__((target("avx2,popcnt")))
+int __bitmatrix__and_count_avx2(uint64_t* r1, uint64_t* r2, uint64_t* b, int n){
+  int count = 0;
+  int i = 0;
+  uint64_t words[4];
+  for(; i + 4 <= n; i += 4){
+    __m256i a = _mm256_loadu_si256((__m256i*)&r1[i]);
+    if(r2 != NULL)
+      a = _mm256_or_si256(a,_mm256_loadu_si256((__m256i*)&r2[i]));
+    _mm256_storeu_si256((__m256i*)words,_mm256_and_si256(a,_mm256_loadu_si256((__m256i*)&b[i])));
+    count += __builtin_popcountll(words[0]) + __builtin_popcountll(words[1]) + __builtin_popcountll(words[2]) + __builtin_popcountll(words[3]);
+  }
+  for(; i < n; i++)
+    count += __builtin_popcountll((r2 != NULL ? r1[i] | r2[i] : r1[i]) & b[i]);
+  return count;
+}
+
+__attribute__((target("avx2")))
+void __bitmatrix__or_avx2(uint64_t* r1, uint64_t* b, int n){
+  int i = 0;
+  for(; i + 4 <= n; i += 4)
+    _mm256_storeu_si256((__m256i*)&b[i],_mm256_or_si256(_mm256_loadu_si256((__m256i*)&b[i]),_mm256_loadu_si256((__m256i*)&r1[i])));
+  __bitmatrix__or_scalar(&r1[i], &b[i], n-i);
+}
+#endif
+
+// the row kernels, determined on first use (__bitmatrix__intersect is set
+// last, so the others are set once it is)
+int (*__bitmatrix__intersect)(uint64_t*, uint64_t*, uint64_t*, int) = NULL;
+int (*__bitmatrix__and_count)(uint64_t*, uint64_t*, uint64_t*, int) = NULL;
+void (*__bitmatrix__or)(uint64_t*, uint64_t*, int) = NULL;
+
+void __bitmatrix__select_kernels(){
+  __bitmatrix__and_count = __bitmatrix__and_count_scalar;
+  __bitmatrix__or = __bitmatrix__or_scalar;
+#ifdef BITSET_AVX2_DISPATCH
+  if(__builtin_cpu_supports("avx2")){
+    __bitmatrix__or = __bitmatrix__or_avx2;
+    if(__builtin_cpu_supports("popcnt"))
+      __bitmatrix__and_count = __bitmatrix__and_count_avx2;
+    __atomic_store_n(&__bitmatrix__intersect,__bitmatrix__intersect_avx2,__ATOMIC_RELEASE);
+    return;
+  }
+#endif
+  __atomic_store_n(&__bitmatrix__intersect,__bitmatrix__intersect_scalar,__ATOMIC_RELEASE);
+}
+
+/**
+ * Returns TRUE iff the given row of the first matrix OR the given row of the
+ * second matrix (if not NULL) shares a set bit with the given bitset.
+ */
+int bitmatrix__rows_intersect(struct BitMatrix* matrix1, struct BitMatrix* matrix2, int row, struct BitSet* bitset){
+  if(__atomic_load_n(&__bitmatrix__intersect,__ATOMIC_ACQUIRE) == NULL)
+    __bitmatrix__select_kernels();
+  return __bitmatrix__intersect(bitmatrix__row(matrix1,row), matrix2 != NULL ? bitmatrix__row(matrix2,row) : NULL, bitset->data, bitset->num_elements);
+}
+
+/**
+ * Returns the number of bits set both in the given bitset and in the given row
+ * of the first matrix OR the given row of the second matrix (if not NULL).
+ */
+int bitmatrix__rows_and_count(struct BitMatrix* matrix1, struct BitMatrix* matrix2, int row, struct BitSet* bitset){
+  if(__atomic_load_n(&__bitmatrix__intersect,__ATOMIC_ACQUIRE) == NULL)
+    __bitmatrix__select_kernels();
+  return __bitmatrix__and_count(bitmatrix__row(matrix1,row), matrix2 != NULL ? bitmatrix__row(matrix2,row) : NULL, bitset->data, bitset->num_elements);
+}
+
+/** bitset = bitset OR the given row of the matrix */
+void bitmatrix__row_or(struct BitMatrix* matrix, int row, struct BitSet* bitset){
+  if(__atomic_load_n(&__bitmatrix__intersect,__ATOMIC_ACQUIRE) == NULL)
+    __bitmatrix__select_kernels();
+  __bitmatrix__or(bitmatrix__row(matrix,row), bitset->data, bitset->num_elements);
+}
+
+/** free allocated memory */
+void bitmatrix__destroy(struct BitMatrix* matrix){
+  mem__free(matrix->data);
+  free(matrix);
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
@@ -10,105 +10,238 @@
  Description : A simple bitset implementation.
  ============================================================================
  */
-#define WORD_BITS (8 * sizeof(unsigned int))
+#define WORD_BITS 64
+
+// AVX2 kernels for bulk operations are compiled for x86 with GCC/clang and
+// selected at runtime if the CPU supports them
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITSET_AVX2_DISPATCH
+#endif
 
 /* A bit set structure */
 struct BitSet{
-	unsigned int* data;
+	uint64_t* data;
 	// number of bits
 	int length;
-	// number of ints
+	// number of words
 	int num_elements;
 };
 
+/* An iterator over the set bits of a bit set */
+struct BitSetIterator{
+	struct BitSet* bitset;
+	// the index of the current word
+	int word;
+	// the bits of the current word not yet returned
+	uint64_t current;
+};
+
+/** clears the bits of the last word beyond the length of the bit set */
+void __bitset__clear_tail(struct BitSet* bitset){
+	int last = bitset->length / WORD_BITS;
+	if(bitset->length % WORD_BITS != 0)
+		bitset->data[last] &= (~0ULL) >> (WORD_BITS - bitset->length % WORD_BITS);
+	else
+		bitset->data[last] = 0;
+	for(int i = last+1; i < bitset->num_elements; i++)
+		bitset->data[i] = 0;
+}
+
 /** Init bit set. */
 void bitset__init(struct BitSet* bitset, int length){
 	bitset->num_elements = ((length/WORD_BITS)+1);
-	bitset->data = malloc(bitset->num_elements * sizeof(unsigned int));
+	bitset->data = mem__alloc(bitset->num_elements * sizeof(uint64_t));
 	bitset->length = length;
 }
 
+/**
+ * Returns a new bit set (all bits zero) that is allocated from the given arena;
+ * it is released with the arena and must neither be resized nor destroyed.
+ */
+struct BitSet* bitset__init_in(int length, struct Arena* arena){
+	struct BitSet* bitset = arena__alloc(arena, sizeof(struct BitSet));
+	bitset->num_elements = ((length/WORD_BITS)+1);
+	bitset->data = arena__calloc(arena, bitset->num_elements * sizeof(uint64_t));
+	bitset->length = length;
+	return bitset;
+}
+
 /**
  * Randomly sets the bits in this bitset
  */
-void bitset__randomize(struct BitSet* bitset){
-	for(int i = 0; i < bitset->num_elements; i++)
-		bitset->data[i] = rand();
+void bitset__randomize(struct BitSet* bitset, struct Rng* rng){
+	rng__fill(rng, bitset->data, bitset->num_elements);
+	__bitset__clear_tail(bitset);
 }
 
 /** Clones the first bitset */
 void bitset__clone(struct BitSet* bitset1, struct BitSet* bitset2){
 	bitset2->num_elements = bitset1->num_elements;
 	bitset2->length = bitset1->length;
-	bitset2->data = malloc(bitset2->num_elements * sizeof(unsigned int));
-	memcpy(bitset2->data,bitset1->data,bitset2->num_elements*sizeof(unsigned int));
+	bitset2->data = mem__alloc(bitset2->num_elements * sizeof(uint64_t));
+	memcpy(bitset2->data,bitset1->data,bitset2->num_elements*sizeof(uint64_t));
 }
 
 /** set a value in a bitset **/
 void bitset__set(struct BitSet* bitset, size_t idx) {
-	bitset->data[idx / WORD_BITS] |= (1 << (idx % WORD_BITS));
+	bitset->data[idx / WORD_BITS] |= (1ULL << (idx % WORD_BITS));
 }
 
 /** sets all bits */
 void bitset__setAll(struct BitSet* bitset){
-	memset(bitset->data, ~0, bitset->num_elements * sizeof(unsigned int));
+	memset(bitset->data, ~0, bitset->num_elements * sizeof(uint64_t));
+	__bitset__clear_tail(bitset);
 }
 
 /** unset a value in a bitset **/
 void bitset__unset(struct BitSet* bitset, size_t idx) {
-	bitset->data[idx / WORD_BITS] &= ~(1 << (idx % WORD_BITS));
+	bitset->data[idx / WORD_BITS] &= ~(1ULL << (idx % WORD_BITS));
 }
 
 /** unsets all bits */
 void bitset__unsetAll(struct BitSet* bitset){
-	memset(bitset->data, 0, bitset->num_elements * sizeof(unsigned int));
+	memset(bitset->data, 0, bitset->num_elements * sizeof(uint64_t));
 }
 
 /** get value of bit in bitset **/
 int bitset__get(struct BitSet* bitset, size_t idx){
-	return ((bitset->data[idx / WORD_BITS]) & (1<<(idx % WORD_BITS)));
+	return ((bitset->data[idx / WORD_BITS]) >> (idx % WORD_BITS)) & 1;
 }
 
 /** Returns the index of the next set bit starting from given idx (it may
  * return idx itself), or -1 if no more set bit found. */
 int bitset__next_set_bit(struct BitSet* bitset, int idx){
-	//TODO make this more efficient?
-	int i,j;
-	int elem = idx/WORD_BITS;
-	if(bitset->data[elem] != 0){
-		for(j = idx; bitset__get(bitset,j) == 0 && j < (elem+1)*WORD_BITS && j < bitset->length; j++ );
-		if(j >= bitset->length) return -1;
-		if(j < (elem+1)*WORD_BITS){
-			return j;
-		}
+	if(idx >= bitset->length)
+		return -1;
+	int i = idx / WORD_BITS;
+	uint64_t word = bitset->data[i] & ((~0ULL) << (idx % WORD_BITS));
+	while(word == 0){
+		if(++i >= bitset->num_elements)
+			return -1;
+		word = bitset->data[i];
+	}
+	int j = i * WORD_BITS + __builtin_ctzll(word);
+	return j < bitset->length ? j : -1;
+}
+
+/** Initialises an iterator over the set bits of the given bit set */
+void bitset__iterator_init(struct BitSetIterator* it, struct BitSet* bitset){
+	it->bitset = bitset;
+	it->word = 0;
+	it->current = bitset->data[0];
+}
+
+/** Returns the next set bit of the iterator or -1 if there are no more */
+int bitset__iterator_next(struct BitSetIterator* it){
+	while(it->current == 0){
+		if(++it->word >= it->bitset->num_elements)
+			return -1;
+		it->current = it->bitset->data[it->word];
 	}
-	if(elem+1 >= bitset->num_elements) return -1;
-	for(i = elem+1; i < bitset->num_elements && bitset->data[i] ==0; i++);
-	if(i >= bitset->num_elements) return -1;
-	for(j = i * WORD_BITS; bitset__get(bitset,j) == 0 && j < bitset->length; j++ );
-	if(j >= bitset->length) return -1;
-	return j;
+	int j = it->word * WORD_BITS + __builtin_ctzll(it->current);
+	// clear the lowest set bit
+	it->current &= it->current - 1;
+	return j < it->bitset->length ? j : -1;
 }
 
 /** resizes the bit set */
 void bitset__resize(struct BitSet* bitset, int new_length, int value){
-	bitset->num_elements = ((new_length/WORD_BITS)+1);
-	bitset->data = realloc(bitset->data, bitset->num_elements * sizeof(unsigned int));
 	int old_length = bitset->length;
+	int old_num_elements = bitset->num_elements;
+	bitset->num_elements = ((new_length/WORD_BITS)+1);
+	bitset->data = mem__realloc(bitset->data, bitset->num_elements * sizeof(uint64_t));
 	bitset->length = new_length;
-	// set values to default value
-	// TODO make this more efficient
-	if(value)
-		for(int i = old_length; i < new_length; i++)
-			bitset__set(bitset, i);
+	if(new_length <= old_length){
+		__bitset__clear_tail(bitset);
+		return;
+	}
+	// set values to default value (word-wise from the word containing old_length)
+	int first = old_length / WORD_BITS;
+	uint64_t low = old_length % WORD_BITS == 0 ? 0 : ((~0ULL) >> (WORD_BITS - old_length % WORD_BITS));
+	if(first < old_num_elements)
+		bitset->data[first] = value ? (bitset->data[first] | ~low) : (bitset->data[first] & low);
 	else
-		for(int i = old_length; i < new_length; i++)
-			bitset__unset(bitset, i);
+		bitset->data[first] = value ? ~low : 0;
+	for(int i = first+1; i < bitset->num_elements; i++)
+		bitset->data[i] = value ? ~0ULL : 0;
+	__bitset__clear_tail(bitset);
+}
+
+/** Returns the number of set bits */
+int bitset__count(struct BitSet* bitset){
+	long count = 0;
+	for(int i = 0; i < bitset->num_elements; i++)
+		count += __builtin_popcountll(bitset->data[i]);
+	return (int)count;
+}
+
+#define BITSET_OP_UNION 0
+#define BITSET_OP_INTERSECT 1
+#define BITSET_OP_ANDNOT 2
+
+// scalar kernel for bulk operations: dst = dst op src on the first n words
+void __bitset__bulk_scalar(uint64_t* dst, uint64_t* src, int n, int op){
+	if(op == BITSET_OP_UNION)
+		for(int i = 0; i < n; i++) dst[i] |= src[i];
+	else if(op == BITSET_OP_INTERSECT)
+		for(int i = 0; i < n; i++) dst[i] &= src[i];
+	else
+		for(int i = 0; i < n; i++) dst[i] &= ~src[i];
+}
+
+#ifdef BITSET_AVX2_DISPATCH
+// AVX2 kernel for bulk operations: dst = dst op src on the first n words
+__attribute__((target("avx2")))
+void __bitset__bulk_avx2(uint64_t* dst, uint64_t* src, int n, int op){
+	int i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m256i a = _mm256_loadu_si256((__m256i*)&dst[i]);
+		__m256i b = _mm256_loadu_si256((__m256i*)&src[i]);
+		if(op == BITSET_OP_UNION)
+			a = _mm256_or_si256(a,b);
+		else if(op == BITSET_OP_INTERSECT)
+			a = _mm256_and_si256(a,b);
+		else
+			a = _mm256_andnot_si256(b,a);
+		_mm256_storeu_si256((__m256i*)&dst[i],a);
+	}
+	__bitset__bulk_scalar(&dst[i], &src[i], n-i, op);
+}
+#endif
+
+// the kernel for bulk operations, determined on first use
+void (*__bitset__bulk)(uint64_t*, uint64_t*, int, int) = NULL;
+
+// applies dst = dst op src on the words both bit sets have in common
+void __bitset__bulk_op(struct BitSet* dst, struct BitSet* src, int op){
+	if(__bitset__bulk == NULL){
+		__bitset__bulk = __bitset__bulk_scalar;
+#ifdef BITSET_AVX2_DISPATCH
+		if(__builtin_cpu_supports("avx2"))
+			__bitset__bulk = __bitset__bulk_avx2;
+#endif
+	}
+	__bitset__bulk(dst->data, src->data, dst->num_elements < src->num_elements ? dst->num_elements : src->num_elements, op);
+}
+
+/** bitset1 = bitset1 OR bitset2 */
+void bitset__union(struct BitSet* bitset1, struct BitSet* bitset2){
+	__bitset__bulk_op(bitset1, bitset2, BITSET_OP_UNION);
+}
+
+/** bitset1 = bitset1 AND bitset2 */
+void bitset__intersect(struct BitSet* bitset1, struct BitSet* bitset2){
+	__bitset__bulk_op(bitset1, bitset2, BITSET_OP_INTERSECT);
+}
+
+/** bitset1 = bitset1 AND NOT bitset2 */
+void bitset__andnot(struct BitSet* bitset1, struct BitSet* bitset2){
+	__bitset__bulk_op(bitset1, bitset2, BITSET_OP_ANDNOT);
 }
 
 /** free allocated memory */
 void bitset__destroy(struct BitSet* bitset){
-	free(bitset->data);
+	mem__free(bitset->data);
 	free(bitset);
 }
 
@@ -0,0 +1,627 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : cdcl.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A small CDCL SAT solver (two watched literals, first-UIP
+               clause learning, VSIDS, phase saving, Luby restarts, and
+               reduction of the learned clauses by LBD).
+               Variables are 0,...,n-1; the literals of variable v are
+               2*v (positive) and 2*v+1 (negative).
+ ============================================================================
+ */
+
+#define CDCL_UNSAT 0
+#define CDCL_SAT 1
+#define CDCL_UNKNOWN -1
+
+// the literal of the given variable with the given sign
+#define CDCL_LIT(var,positive) (2*(var) + ((positive) ? 0 : 1))
+#define CDCL_VAR(lit) ((lit) >> 1)
+#define CDCL_NEG(lit) ((lit) ^ 1)
+// no reason (decisions and unassigned variables)
+#define CDCL_NO_REASON -1
+
+// the number of conflicts of the first restart (multiplied with the Luby sequence)
+#define CDCL_RESTART_BASE 100
+// the number of conflicts before the first reduction of the learned clauses
+#define CDCL_REDUCE_BASE 2000
+// the increment of the number of conflicts between reductions
+#define CDCL_REDUCE_INC 300
+
+// a growing array of ints
+struct CdclVector{
+  int* data;
+  int size;
+  int capacity;
+};
+
+static inline void __cdcl__push(struct CdclVector* v, int value){
+  if(v->size == v->capacity){
+    v->capacity = v->capacity == 0 ? 4 : 2 * v->capacity;
+    v->data = realloc(v->data, v->capacity * sizeof(int));
+  }
+  v->data[v->size++] = value;
+}
+
+// a watch: a clause (its position in the clause database) and a literal of
+// the clause (if that "blocker" is true the clause is skipped)
+struct CdclWatch{
+  long clause;
+  int blocker;
+};
+
+// a growing array of watches
+struct CdclWatchVector{
+  struct CdclWatch* data;
+  int size;
+  int capacity;
+};
+
+// a growing array of clauses (positions in the clause database)
+struct CdclClauseVector{
+  long* data;
+  int size;
+  int capacity;
+};
+
+static inline void __cdcl__push_clause(struct CdclClauseVector* v, long clause){
+  if(v->size == v->capacity){
+    v->capacity = v->capacity == 0 ? 4 : 2 * v->capacity;
+    v->data = realloc(v->data, v->capacity * sizeof(long));
+  }
+  v->data[v->size++] = clause;
+}
+
+struct CdclSolver{
+  int number_of_variables;
+  // all clauses: a clause starting at position c has the header
+  // db[c] = size, db[c+1] = learned (0/1), db[c+2] = LBD, followed by its literals
+  int* db;
+  long db_size;
+  long db_capacity;
+  // the (positions of) the learned clauses
+  struct CdclClauseVector learned;
+  // for each literal the clauses watching it
+  struct CdclWatchVector* watches;
+  // for each variable its value (1 true, -1 false, 0 unassigned)
+  signed char* values;
+  // for each variable its decision level and the clause that implied it
+  int* levels;
+  long* reasons;
+  // the assigned literals in order of assignment
+  int* trail;
+  int trail_size;
+  int propagated;
+  // trail_limits[d] is the size of the trail at decision level d+1
+  int* trail_limits;
+  int decision_level;
+  // VSIDS: activities of the variables and a heap of the unassigned ones
+  double* activities;
+  double activity_inc;
+  int* heap;
+  int heap_size;
+  int* heap_index;
+  // the value each variable was assigned last (the phase of decisions)
+  signed char* phases;
+  // buffers of the conflict analysis
+  char* seen;
+  struct CdclVector learned_clause;
+  int* level_stamps;
+  int level_stamp;
+  // FALSE iff the clauses are unsatisfiable at decision level 0
+  int ok;
+  long conflicts;
+  // if not NULL the search is aborted as soon as *stop is TRUE
+  int* stop;
+  // if not -1 the search is aborted after this number of conflicts
+  long max_conflicts;
+};
+
+/* ============================================================================================================== */
+/* == VSIDS heap (max-heap on the activities) ================================================================== */
+/* ============================================================================================================== */
+
+void __cdcl__heap_up(struct CdclSolver* s, int i){
+  int var = s->heap[i];
+  while(i > 0 && s->activities[s->heap[(i-1)/2]] < s->activities[var]){
+    s->heap[i] = s->heap[(i-1)/2];
+    s->heap_index[s->heap[i]] = i;
+    i = (i-1)/2;
+  }
+  s->heap[i] = var;
+  s->heap_index[var] = i;
+}
+
+void __cdcl__heap_down(struct CdclSolver* s, int i){
+  int var = s->heap[i];
+  for(;;){
+    int child = 2*i+1;
+    if(child >= s->heap_size)
+      break;
+    if(child+1 < s->heap_size && s->activities[s->heap[child+1]] > s->activities[s->heap[child]])
+      child++;
+    if(s->activities[s->heap[child]] <= s->activities[var])
+      break;
+    s->heap[i] = s->heap[child];
+    s->heap_index[s->heap[i]] = i;
+    i = child;
+  }
+  s->heap[i] = var;
+  s->heap_index[var] = i;
+}
+
+void __cdcl__heap_insert(struct CdclSolver* s, int var){
+  if(s->heap_index[var] != -1)
+    return;
+  s->heap[s->heap_size] = var;
+  s->heap_index[var] = s->heap_size++;
+  __cdcl__heap_up(s, s->heap_size-1);
+}
+
+int __cdcl__heap_pop(struct CdclSolver* s){
+  int var = s->heap[0];
+  s->heap_index[var] = -1;
+  if(--s->heap_size > 0){
+    s->heap[0] = s->heap[s->heap_size];
+    s->heap_index[s->heap[0]] = 0;
+    __cdcl__heap_down(s, 0);
+  }
+  return var;
+}
+
+void __cdcl__bump(struct CdclSolver* s, int var){
+  if((s->activities[var] += s->activity_inc) > 1e100){
+    for(int v = 0; v < s->number_of_variables; v++)
+      s->activities[v] *= 1e-100;
+    s->activity_inc *= 1e-100;
+  }
+  if(s->heap_index[var] != -1)
+    __cdcl__heap_up(s, s->heap_index[var]);
+}
+
+/* ============================================================================================================== */
+/* ============================================================================================================== */
+
+/**
+ * Initialises a solver with the given number of variables and no clauses.
+ */
+void cdcl__init(struct CdclSolver* s, int number_of_variables){
+  int n = number_of_variables > 0 ? number_of_variables : 1;
+  s->number_of_variables = number_of_variables;
+  s->db_capacity = 1024;
+  s->db = mem__alloc(s->db_capacity * sizeof(int));
+  s->db_size = 0;
+  s->learned.data = NULL;
+  s->learned.size = s->learned.capacity = 0;
+  s->watches = calloc(2*n, sizeof(struct CdclWatchVector));
+  s->values = calloc(n, sizeof(signed char));
+  s->levels = calloc(n, sizeof(int));
+  s->reasons = malloc(n * sizeof(long));
+  s->trail = malloc(n * sizeof(int));
+  s->trail_size = 0;
+  s->propagated = 0;
+  s->trail_limits = malloc(n * sizeof(int));
+  s->decision_level = 0;
+  s->activities = calloc(n, sizeof(double));
+  s->activity_inc = 1;
+  s->heap = malloc(n * sizeof(int));
+  s->heap_index = malloc(n * sizeof(int));
+  s->heap_size = 0;
+  s->phases = malloc(n * sizeof(signed char));
+  s->seen = calloc(n, sizeof(char));
+  s->learned_clause.data = NULL;
+  s->learned_clause.size = s->learned_clause.capacity = 0;
+  s->level_stamps = calloc(n+1, sizeof(int));
+  s->level_stamp = 0;
+  s->ok = TRUE;
+  s->conflicts = 0;
+  s->stop = NULL;
+  s->max_conflicts = -1;
+  for(int v = 0; v < number_of_variables; v++){
+    s->reasons[v] = CDCL_NO_REASON;
+    s->phases[v] = -1;
+    s->heap_index[v] = -1;
+    __cdcl__heap_insert(s, v);
+  }
+}
+
+void cdcl__destroy(struct CdclSolver* s){
+  int n = s->number_of_variables > 0 ? s->number_of_variables : 1;
+  mem__free(s->db);
+  free(s->learned.data);
+  for(int l = 0; l < 2*n; l++)
+    free(s->watches[l].data);
+  free(s->watches);
+  free(s->values);
+  free(s->levels);
+  free(s->reasons);
+  free(s->trail);
+  free(s->trail_limits);
+  free(s->activities);
+  free(s->heap);
+  free(s->heap_index);
+  free(s->phases);
+  free(s->seen);
+  free(s->learned_clause.data);
+  free(s->level_stamps);
+}
+
+// the value of the given literal (1 true, -1 false, 0 unassigned)
+static inline int __cdcl__lit_value(struct CdclSolver* s, int lit){
+  int value = s->values[CDCL_VAR(lit)];
+  return (lit & 1) ? -value : value;
+}
+
+static inline void __cdcl__assign(struct CdclSolver* s, int lit, long reason){
+  int var = CDCL_VAR(lit);
+  s->values[var] = (lit & 1) ? -1 : 1;
+  s->levels[var] = s->decision_level;
+  s->reasons[var] = reason;
+  s->trail[s->trail_size++] = lit;
+}
+
+static inline void __cdcl__watch(struct CdclSolver* s, int lit, long clause, int blocker){
+  struct CdclWatchVector* ws = &s->watches[lit];
+  if(ws->size == ws->capacity){
+    ws->capacity = ws->capacity == 0 ? 4 : 2 * ws->capacity;
+    ws->data = realloc(ws->data, ws->capacity * sizeof(struct CdclWatch));
+  }
+  ws->data[ws->size].clause = clause;
+  ws->data[ws->size++].blocker = blocker;
+}
+
+// stores a clause (of at least two literals) and watches its first two literals
+long __cdcl__store(struct CdclSolver* s, int* lits, int size, int learned, int lbd){
+  if(s->db_size + size + 3 > s->db_capacity){
+    while(s->db_size + size + 3 > s->db_capacity)
+      s->db_capacity *= 2;
+    s->db = mem__realloc(s->db, s->db_capacity * sizeof(int));
+  }
+  long c = s->db_size;
+  s->db[c] = size;
+  s->db[c+1] = learned;
+  s->db[c+2] = lbd;
+  memcpy(&s->db[c+3], lits, size * sizeof(int));
+  s->db_size += size + 3;
+  __cdcl__watch(s, lits[0], c, lits[1]);
+  __cdcl__watch(s, lits[1], c, lits[0]);
+  return c;
+}
+
+/**
+ * Sets the value the given variable gets when it is first decided
+ * (the value it was assigned last afterwards).
+ */
+void cdcl__set_phase(struct CdclSolver* s, int var, int value){
+  s->phases[var] = value ? 1 : -1;
+}
+
+/**
+ * Adds a clause (at decision level 0, i.e., before cdcl__solve()); returns
+ * FALSE iff the clauses have become unsatisfiable.
+ */
+int cdcl__add_clause(struct CdclSolver* s, int* lits, int size){
+  if(!s->ok)
+    return FALSE;
+  // remove false and duplicate literals; drop satisfied clauses (and
+  // tautologies); the literals taken are marked in "seen" (1 positive,
+  // 2 negative), which is cleared again afterwards
+  struct CdclVector* clause = &s->learned_clause;
+  clause->size = 0;
+  int satisfied = FALSE;
+  for(int i = 0; i < size && !satisfied; i++){
+    int value = __cdcl__lit_value(s, lits[i]);
+    if(value == 1)
+      satisfied = TRUE;
+    if(value != 0)
+      continue;
+    char mark = (lits[i] & 1) ? 2 : 1;
+    char* seen = &s->seen[CDCL_VAR(lits[i])];
+    if(*seen == 0){
+      *seen = mark;
+      __cdcl__push(clause, lits[i]);
+    }else if(*seen != mark)
+      satisfied = TRUE;
+  }
+  for(int i = 0; i < clause->size; i++)
+    s->seen[CDCL_VAR(clause->data[i])] = 0;
+  if(satisfied)
+    return TRUE;
+  if(clause->size == 0){
+    s->ok = FALSE;
+    return FALSE;
+  }
+  if(clause->size == 1)
+    __cdcl__assign(s, clause->data[0], CDCL_NO_REASON);
+  else __cdcl__store(s, clause->data, clause->size, FALSE, 0);
+  return TRUE;
+}
+
+// propagates all assignments on the trail; returns the conflicting clause or CDCL_NO_REASON
+long __cdcl__propagate(struct CdclSolver* s){
+  while(s->propagated < s->trail_size){
+    int false_lit = CDCL_NEG(s->trail[s->propagated++]);
+    struct CdclWatchVector* ws = &s->watches[false_lit];
+    int i = 0, j = 0;
+    while(i < ws->size){
+      long c = ws->data[i].clause;
+      int blocker = ws->data[i].blocker;
+      i++;
+      if(__cdcl__lit_value(s, blocker) == 1){
+        ws->data[j++] = ws->data[i-1];
+        continue;
+      }
+      int* lits = &s->db[c+3];
+      int size = s->db[c];
+      if(lits[0] == false_lit){
+        lits[0] = lits[1];
+        lits[1] = false_lit;
+      }
+      int first = lits[0];
+      if(first != blocker && __cdcl__lit_value(s, first) == 1){
+        ws->data[j].clause = c;
+        ws->data[j++].blocker = first;
+        continue;
+      }
+      int moved = FALSE;
+      for(int k = 2; k < size; k++)
+        if(__cdcl__lit_value(s, lits[k]) != -1){
+          lits[1] = lits[k];
+          lits[k] = false_lit;
+          __cdcl__watch(s, lits[1], c, first);
+          moved = TRUE;
+          break;
+        }
+      if(moved)
+        continue;
+      ws->data[j].clause = c;
+      ws->data[j++].blocker = first;
+      if(__cdcl__lit_value(s, first) == -1){
+        while(i < ws->size)
+          ws->data[j++] = ws->data[i++];
+        ws->size = j;
+        s->propagated = s->trail_size;
+        return c;
+      }
+      __cdcl__assign(s, first, c);
+    }
+    ws->size = j;
+  }
+  return CDCL_NO_REASON;
+}
+
+// undoes all assignments above the given decision level
+void __cdcl__backtrack(struct CdclSolver* s, int level){
+  if(s->decision_level <= level)
+    return;
+  for(int i = s->trail_size - 1; i >= s->trail_limits[level]; i--){
+    int var = CDCL_VAR(s->trail[i]);
+    s->phases[var] = s->values[var];
+    s->values[var] = 0;
+    s->reasons[var] = CDCL_NO_REASON;
+    __cdcl__heap_insert(s, var);
+  }
+  s->trail_size = s->trail_limits[level];
+  s->propagated = s->trail_size;
+  s->decision_level = level;
+}
+
+// returns TRUE iff the literal of the learned clause is implied by the other
+// literals of the learned clause (via its reason)
+int __cdcl__redundant(struct CdclSolver* s, int lit){
+  long reason = s->reasons[CDCL_VAR(lit)];
+  if(reason == CDCL_NO_REASON)
+    return FALSE;
+  int* lits = &s->db[reason+3];
+  for(int k = 1; k < s->db[reason]; k++){
+    int var = CDCL_VAR(lits[k]);
+    if(!s->seen[var] && s->levels[var] > 0)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+// analyses the conflict (first UIP); the learned clause is stored in
+// learned_clause (asserting literal first); returns the backtrack level
+int __cdcl__analyse(struct CdclSolver* s, long conflict, int* lbd){
+  struct CdclVector* clause = &s->learned_clause;
+  clause->size = 0;
+  __cdcl__push(clause, 0);
+  int pending = 0;
+  int lit = -1;
+  int index = s->trail_size - 1;
+  do{
+    int* lits = &s->db[conflict+3];
+    for(int k = (lit == -1 ? 0 : 1); k < s->db[conflict]; k++){
+      int var = CDCL_VAR(lits[k]);
+      if(s->seen[var] || s->levels[var] == 0)
+        continue;
+      s->seen[var] = 1;
+      __cdcl__bump(s, var);
+      if(s->levels[var] == s->decision_level)
+        pending++;
+      else __cdcl__push(clause, lits[k]);
+    }
+    while(!s->seen[CDCL_VAR(s->trail[index])])
+      index--;
+    lit = s->trail[index--];
+    conflict = s->reasons[CDCL_VAR(lit)];
+    s->seen[CDCL_VAR(lit)] = 0;
+    pending--;
+  }while(pending > 0);
+  clause->data[0] = CDCL_NEG(lit);
+  // remove literals implied by the others (marked first, as the check needs
+  // all of them to be seen)
+  for(int i = 1; i < clause->size; i++)
+    if(__cdcl__redundant(s, clause->data[i]))
+      clause->data[i] = -1 - clause->data[i];
+  int j = 1;
+  for(int i = 1; i < clause->size; i++){
+    int lit = clause->data[i] < 0 ? -1 - clause->data[i] : clause->data[i];
+    s->seen[CDCL_VAR(lit)] = 0;
+    if(clause->data[i] >= 0)
+      clause->data[j++] = lit;
+  }
+  clause->size = j;
+  // the literal with the highest level goes second (it is watched)
+  int backtrack_level = 0;
+  for(int i = 1; i < clause->size; i++)
+    if(s->levels[CDCL_VAR(clause->data[i])] > backtrack_level){
+      backtrack_level = s->levels[CDCL_VAR(clause->data[i])];
+      int tmp = clause->data[1];
+      clause->data[1] = clause->data[i];
+      clause->data[i] = tmp;
+    }
+  // the number of different decision levels in the clause
+  s->level_stamp++;
+  *lbd = 0;
+  for(int i = 0; i < clause->size; i++){
+    int level = s->levels[CDCL_VAR(clause->data[i])];
+    if(s->level_stamps[level] != s->level_stamp){
+      s->level_stamps[level] = s->level_stamp;
+      (*lbd)++;
+    }
+  }
+  return backtrack_level;
+}
+
+// a learned clause and its LBD (for sorting)
+struct CdclLearned{
+  int lbd;
+  long clause;
+};
+
+int __cdcl__compare_learned(const void* a, const void* b){
+  return ((const struct CdclLearned*)b)->lbd - ((const struct CdclLearned*)a)->lbd;
+}
+
+// removes half of the learned clauses (those with the highest LBD, but none
+// with LBD at most 2), compacts the clause database and rebuilds the watches;
+// must be called at decision level 0, where no clause is needed as a reason
+void __cdcl__reduce(struct CdclSolver* s){
+  for(int i = 0; i < s->trail_size; i++)
+    s->reasons[CDCL_VAR(s->trail[i])] = CDCL_NO_REASON;
+  struct CdclLearned* learned = malloc((s->learned.size > 0 ? s->learned.size : 1) * sizeof(struct CdclLearned));
+  for(int i = 0; i < s->learned.size; i++){
+    learned[i].clause = s->learned.data[i];
+    learned[i].lbd = s->db[s->learned.data[i]+2];
+  }
+  qsort(learned, s->learned.size, sizeof(struct CdclLearned), __cdcl__compare_learned);
+  for(int i = 0; i < s->learned.size / 2; i++)
+    if(learned[i].lbd > 2)
+      s->db[learned[i].clause+1] = -1;
+  free(learned);
+  for(int l = 0; l < 2 * s->number_of_variables; l++)
+    s->watches[l].size = 0;
+  s->learned.size = 0;
+  long new_size = 0;
+  for(long c = 0; c < s->db_size; ){
+    long next = c + s->db[c] + 3;
+    if(s->db[c+1] != -1){
+      memmove(&s->db[new_size], &s->db[c], (s->db[c] + 3) * sizeof(int));
+      __cdcl__watch(s, s->db[new_size+3], new_size, s->db[new_size+4]);
+      __cdcl__watch(s, s->db[new_size+4], new_size, s->db[new_size+3]);
+      if(s->db[new_size+1])
+        __cdcl__push_clause(&s->learned, new_size);
+      new_size += s->db[new_size] + 3;
+    }
+    c = next;
+  }
+  s->db_size = new_size;
+}
+
+/**
+ * Solves the clauses; returns CDCL_SAT (then cdcl__value() gives the
+ * model), CDCL_UNSAT, or CDCL_UNKNOWN if the search has been stopped
+ * (by "stop" or "max_conflicts").
+ */
+int cdcl__solve(struct CdclSolver* s){
+  if(!s->ok || __cdcl__propagate(s) != CDCL_NO_REASON){
+    s->ok = FALSE;
+    return CDCL_UNSAT;
+  }
+  long restart_conflicts = 0;
+  long next_reduce = CDCL_REDUCE_BASE;
+  int luby_index = 0;
+  for(;;){
+    // the Luby sequence 1,1,2,1,1,2,4,...
+    long size = 1, seq = 0;
+    while(size < luby_index + 1){
+      seq++;
+      size = 2 * size + 1;
+    }
+    long x = luby_index;
+    while(size - 1 != x){
+      size = (size - 1) >> 1;
+      seq--;
+      x = x % size;
+    }
+    long restart_limit = CDCL_RESTART_BASE * (1L << seq);
+    luby_index++;
+    restart_conflicts = 0;
+    for(;;){
+      long conflict = __cdcl__propagate(s);
+      if(conflict != CDCL_NO_REASON){
+        s->conflicts++;
+        restart_conflicts++;
+        if(s->decision_level == 0){
+          s->ok = FALSE;
+          return CDCL_UNSAT;
+        }
+        int lbd;
+        int backtrack_level = __cdcl__analyse(s, conflict, &lbd);
+        __cdcl__backtrack(s, backtrack_level);
+        if(s->learned_clause.size == 1)
+          __cdcl__assign(s, s->learned_clause.data[0], CDCL_NO_REASON);
+        else{
+          long c = __cdcl__store(s, s->learned_clause.data, s->learned_clause.size, TRUE, lbd);
+          __cdcl__push_clause(&s->learned, c);
+          __cdcl__assign(s, s->learned_clause.data[0], c);
+        }
+        s->activity_inc *= 1.0 / 0.95;
+        if(s->stop != NULL && __atomic_load_n(s->stop,__ATOMIC_RELAXED))
+          return CDCL_UNKNOWN;
+        if(s->max_conflicts != -1 && s->conflicts >= s->max_conflicts)
+          return CDCL_UNKNOWN;
+        continue;
+      }
+      if(restart_conflicts >= restart_limit){
+        __cdcl__backtrack(s, 0);
+        if(s->conflicts >= next_reduce){
+          next_reduce = s->conflicts + CDCL_REDUCE_BASE + CDCL_REDUCE_INC * (next_reduce / CDCL_REDUCE_BASE);
+          __cdcl__reduce(s);
+        }
+        break;
+      }
+      // decide
+      int var = -1;
+      while(s->heap_size > 0){
+        int candidate = __cdcl__heap_pop(s);
+        if(s->values[candidate] == 0){
+          var = candidate;
+          break;
+        }
+      }
+      if(var == -1)
+        return CDCL_SAT;
+      s->trail_limits[s->decision_level++] = s->trail_size;
+      __cdcl__assign(s, CDCL_LIT(var, s->phases[var] == 1), CDCL_NO_REASON);
+    }
+  }
+}
+
+/**
+ * Returns the value (TRUE/FALSE) of the given variable in the model found.
+ */
+int cdcl__value(struct CdclSolver* s, int var){
+  return s->values[var] == 1;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
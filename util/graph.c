@@ -27,6 +27,8 @@ struct OddCycleCollection{
   int* arguments;
   // the number of odd cycles
   int number_of_odd_cycles;
+  // the per-cycle bitsets and rasets are allocated from this arena
+  struct Arena* arena;
 };
 
 // prints one cycle
@@ -62,11 +64,9 @@ int occ__add_cycle(struct OddCycleCollection* occ, struct LinkedList* cycle, str
   occ->oddCycles = realloc(occ->oddCycles, occ->number_of_odd_cycles * sizeof(struct LinkedList*));
   occ->arguments_in_individual_odd_cycles = realloc(occ->arguments_in_individual_odd_cycles, occ->number_of_odd_cycles * sizeof(struct BitSet*));
   occ->arguments_attacking_cycle = realloc(occ->arguments_attacking_cycle, occ->number_of_odd_cycles * sizeof(struct RaSet*));
-  occ->arguments_attacking_cycle[occ->number_of_odd_cycles-1] = raset__init_empty(aaf->number_of_arguments);
+  occ->arguments_attacking_cycle[occ->number_of_odd_cycles-1] = raset__init_empty_in(aaf->number_of_arguments, occ->arena);
   occ->oddCycles[occ->number_of_odd_cycles-1] = cycle;
-  occ->arguments_in_individual_odd_cycles[occ->number_of_odd_cycles-1] = malloc(sizeof(struct BitSet));
-  bitset__init(occ->arguments_in_individual_odd_cycles[occ->number_of_odd_cycles-1], aaf->number_of_arguments);
-  bitset__unsetAll(occ->arguments_in_individual_odd_cycles[occ->number_of_odd_cycles-1]);
+  occ->arguments_in_individual_odd_cycles[occ->number_of_odd_cycles-1] = bitset__init_in(aaf->number_of_arguments, occ->arena);
   int previousArgument = *(int*)cycle->tail->data;
   for(struct LinkedListNode* node = cycle->root; node != NULL; node = node->next){
     bitset__set(occ->arguments_in_odd_cycles,*(int*)node->data);
@@ -82,12 +82,23 @@ int occ__add_cycle(struct OddCycleCollection* occ, struct LinkedList* cycle, str
   return FALSE;
 }
 
+// frees memory of an occ
+void occ__destroy(struct OddCycleCollection* occ){
+  for(int i = 0; i < occ->number_of_odd_cycles; i++)
+    llist__destroy_without_data(occ->oddCycles[i]);
+  free(occ->arguments);
+  free(occ->oddCycles);
+  free(occ->arguments_in_individual_odd_cycles);
+  free(occ->arguments_attacking_cycle);
+  arena__destroy(occ->arena);
+  free(occ);
+}
+
 // constructs an OddCycleCollection for the given AAF
 struct OddCycleCollection* occ__init(struct AAF* aaf){
   struct OddCycleCollection* occ = malloc(sizeof(struct OddCycleCollection));
-  occ->arguments_in_odd_cycles = malloc(sizeof(struct BitSet*));
-  bitset__init(occ->arguments_in_odd_cycles,aaf->number_of_arguments);
-  bitset__unsetAll(occ->arguments_in_odd_cycles);
+  occ->arena = arena__init();
+  occ->arguments_in_odd_cycles = bitset__init_in(aaf->number_of_arguments, occ->arena);
   occ->number_of_odd_cycles = 0;
   occ->oddCycles = realloc(0,1);
   occ->arguments_in_individual_odd_cycles = realloc(0,1);
@@ -234,8 +245,10 @@ struct OddCycleCollection* occ__init(struct AAF* aaf){
   bitset__destroy(pathToStart);
   bitset__destroy(oddPathToStart);
   free(argToStart);
-  if(unattacked_odd_cycle_found)
+  if(unattacked_odd_cycle_found){
+    occ__destroy(occ);
     return NULL;
+  }
   return occ;
 }
 
@@ -253,15 +266,6 @@ struct RaSet* occ__get_attackers(struct OddCycleCollection* occ, int node){
       return occ->arguments_attacking_cycle[i];
   return NULL;
 }
-// frees memory of an occ
-void occ__destroy(struct OddCycleCollection* occ){
-  for(int i = 0; i < occ->number_of_odd_cycles; i++)
-    llist__destroy_without_listanddata(occ->oddCycles[i]);
-  free(occ->arguments);
-  free(occ->oddCycles);
-  free(occ);
-}
-
 // computes the set of strongly connected components using Tarjan's algorithm
 // (internal recursive sub function)
 int __scc__compute_strongly_connected_components(int idx, int v,struct LinkedList* stack,struct LinkedList* sccs,struct AAF *aaf,int* index,int* lowlink, int* all_arguments){
@@ -309,6 +313,114 @@ struct LinkedList* scc__compute_strongly_connected_components(struct AAF *aaf, i
   return sccs;
 }
 
+/**
+ * Computes the strongly connected components of the sub-graph induced by the
+ * given arguments (all arguments if NULL) with an iterative version of
+ * Tarjan's algorithm on the adjacency arrays; component[arg] is set to the
+ * number of the component of arg (-1 for arguments not in "arguments").
+ * Components are numbered in the order they are completed, i.e., if some
+ * argument of component c attacks some argument of component d != c then
+ * c > d (so decreasing numbers give a topological order). Returns the number
+ * of components.
+ */
+int scc__components(struct AAF *aaf, struct BitSet* arguments, int* component){
+  int n = aaf->number_of_arguments;
+  int* index = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  int* lowlink = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  // the Tarjan stack
+  int* stack = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  int stack_size = 0;
+  // the DFS call stack: the argument and the position of its next child
+  int* call = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  long* next_child = mem__alloc((n > 0 ? n : 1) * sizeof(long));
+  int depth = 0;
+  int idx = 0, number_of_components = 0;
+  for(int i = 0; i < n; i++){
+    index[i] = -1;
+    component[i] = -1;
+  }
+  for(int root = 0; root < n; root++){
+    if(index[root] != -1 || (arguments != NULL && !bitset__get(arguments,root)))
+      continue;
+    index[root] = lowlink[root] = idx++;
+    stack[stack_size++] = root;
+    call[depth] = root;
+    next_child[depth++] = aaf->children_idx[root];
+    while(depth > 0){
+      int v = call[depth-1];
+      if(next_child[depth-1] < aaf->children_idx[v+1]){
+        int w = aaf->children_arr[next_child[depth-1]++];
+        if(arguments != NULL && !bitset__get(arguments,w))
+          continue;
+        if(index[w] == -1){
+          index[w] = lowlink[w] = idx++;
+          stack[stack_size++] = w;
+          call[depth] = w;
+          next_child[depth++] = aaf->children_idx[w];
+        }else if(component[w] == -1 && index[w] < lowlink[v]){
+          // w is still on the Tarjan stack
+          lowlink[v] = index[w];
+        }
+        continue;
+      }
+      if(lowlink[v] == index[v]){
+        int w;
+        do{
+          w = stack[--stack_size];
+          component[w] = number_of_components;
+        }while(w != v);
+        number_of_components++;
+      }
+      depth--;
+      if(depth > 0 && lowlink[v] < lowlink[call[depth-1]])
+        lowlink[call[depth-1]] = lowlink[v];
+    }
+  }
+  mem__free(index);
+  mem__free(lowlink);
+  mem__free(stack);
+  mem__free(call);
+  mem__free(next_child);
+  return number_of_components;
+}
+
+/**
+ * Computes the weakly connected components of the AAF by a breadth-first
+ * search on the adjacency arrays; component[arg] is set to the number of the
+ * component of arg, components are numbered in the order of their smallest
+ * arguments. Returns the number of components.
+ */
+int wcc__components(struct AAF *aaf, int* component){
+  int n = aaf->number_of_arguments;
+  int* queue = mem__alloc((n > 0 ? n : 1) * sizeof(int));
+  int number_of_components = 0;
+  for(int i = 0; i < n; i++)
+    component[i] = -1;
+  for(int root = 0; root < n; root++){
+    if(component[root] != -1)
+      continue;
+    int head = 0, tail = 0;
+    component[root] = number_of_components;
+    queue[tail++] = root;
+    while(head < tail){
+      int arg = queue[head++];
+      for(long k = aaf->children_idx[arg]; k < aaf->children_idx[arg+1]; k++)
+        if(component[aaf->children_arr[k]] == -1){
+          component[aaf->children_arr[k]] = number_of_components;
+          queue[tail++] = aaf->children_arr[k];
+        }
+      for(long k = aaf->parents_idx[arg]; k < aaf->parents_idx[arg+1]; k++)
+        if(component[aaf->parents_arr[k]] == -1){
+          component[aaf->parents_arr[k]] = number_of_components;
+          queue[tail++] = aaf->parents_arr[k];
+        }
+    }
+    number_of_components++;
+  }
+  mem__free(queue);
+  return number_of_components;
+}
+
 // print the set of strongly connected components
 void __scc_print(struct AAF *aaf, struct LinkedList* sccs){
   for(struct LinkedListNode* scc = sccs->root; scc != NULL; scc = scc->next){
@@ -19,6 +19,8 @@
 struct StringHashTable{
 	struct LinkedList* arr;
 	int length;
+	// the buckets' nodes and the string-value pairs are allocated from this arena
+	struct Arena* arena;
 };
 
 /**
@@ -28,8 +30,9 @@ struct StringHashTable{
  */
 void hash__init(struct StringHashTable* table, int length){
 	table->arr = malloc(length * sizeof(struct LinkedList));
+	table->arena = arena__init();
 	for(int i = 0; i < length; i++)
-		llist__init(&table->arr[i]);
+		llist__init_in(&table->arr[i],table->arena);
 	table->length = length;
 }
 
@@ -50,7 +53,7 @@ int hash__hashcode(char* string){
  */
 void hash__insert(struct StringHashTable* table, char* string, int value){
 	int idx = hash__hashcode(string) % table->length;
-	struct StringValuePair* data = malloc(sizeof(struct StringValuePair));
+	struct StringValuePair* data = arena__alloc(table->arena, sizeof(struct StringValuePair));
 	data->string = string;
 	data->value = value;
 	llist__add(&table->arr[idx],data);
@@ -73,7 +76,8 @@ int hash__get(struct StringHashTable* table, char* string){
 }
 
 void hash__destroy(struct StringHashTable* table){
-	llist__destroy(table->arr);
+	arena__destroy(table->arena);
+	free(table->arr);
 	free(table);
 }
 
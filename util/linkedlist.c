@@ -17,7 +17,9 @@
 struct LinkedList{
 	struct LinkedListNode* root;
 	struct LinkedListNode* tail;
-	int length;
+	long length;
+	// if not NULL, nodes are allocated from this arena (and released with it)
+	struct Arena* arena;
 };
 
 /**
@@ -33,18 +35,34 @@ void llist__init(struct LinkedList* list){
 	list->root = NULL;
 	list->tail = NULL;
 	list->length = 0;
+	list->arena = NULL;
+}
+
+/**
+ * Inits an empty linked list whose nodes are allocated from the given arena;
+ * neither nodes nor data of such a list are freed by the functions below.
+ */
+void llist__init_in(struct LinkedList* list, struct Arena* arena){
+	llist__init(list);
+	list->arena = arena;
+}
+
+struct LinkedListNode* __llist__new_node(struct LinkedList* list){
+	if(list->arena != NULL)
+		return arena__alloc(list->arena, sizeof(struct LinkedListNode));
+	return malloc(sizeof(struct LinkedListNode));
 }
 
 /** Adds a new value to the end of the list. */
 void llist__add(struct LinkedList* list, void* data){
 	list->length++;
 	if(list->length == 1){
-		list->root = malloc(sizeof(struct LinkedListNode));
+		list->root = __llist__new_node(list);
 		list->tail = list->root;
 		list->root->data = data;
 		list->root->next = NULL;
 	}else{
-		list->tail->next = malloc(sizeof(struct LinkedListNode));
+		list->tail->next = __llist__new_node(list);
 		list->tail->next->data = data;
 		list->tail->next->next = NULL;
 		list->tail = list->tail->next;
@@ -55,12 +73,12 @@ void llist__add(struct LinkedList* list, void* data){
 void llist__push(struct LinkedList* list, void* data){
 	list->length++;
 	if(list->length == 1){
-		list->root = malloc(sizeof(struct LinkedListNode));
+		list->root = __llist__new_node(list);
 		list->tail = list->root;
 		list->root->data = data;
 		list->root->next = NULL;
 	}else{
-		struct LinkedListNode* newRoot = malloc(sizeof(struct LinkedListNode));
+		struct LinkedListNode* newRoot = __llist__new_node(list);
 		newRoot->next = list->root;
 		newRoot->data = data;
 		list->root = newRoot;
@@ -69,32 +87,13 @@ void llist__push(struct LinkedList* list, void* data){
 
 // returns the idx-element of this list (if it exists)
 // or NULL instead
-void* llist__get(struct LinkedList* list, int idx){
+void* llist__get(struct LinkedList* list, long idx){
 	if(idx+1 > list->length)
 		return NULL;
-	int i = 0;
-	struct LinkedListNode* current = list->root;
-	while(i++ < idx)
-		current = current->next;
-	return current->data;
-}
-
-// returns the idx-element of this list, skipping elements from
-// the given BitSet or NULL instead
-void* llist__get_with_skip(struct LinkedList* list, int idx, struct BitSet* ignore){
-	int i = 0;
+	long i = 0;
 	struct LinkedListNode* current = list->root;
 	while(i++ < idx)
 		current = current->next;
-	int idx2 = 0;
-	while(bitset__get(ignore,*(int*)current->data)){
-		if(idx2 >= list->length)
-			return NULL;
-		if(current->next == NULL)
-			current = list->root;
-		else current = current->next;
-		idx2++;
-	}
 	return current->data;
 }
 
@@ -105,7 +104,8 @@ void* llist__pop(struct LinkedList* list){
 	void* data = list->root->data;
 	struct LinkedListNode* oldRoot = list->root;
 	list->root = list->root->next;
-	free(oldRoot);
+	if(list->arena == NULL)
+		free(oldRoot);
 	list->length--;
 	if(list->length == 0)
 		list->tail = NULL;
@@ -127,7 +127,7 @@ int llist__contains_int(struct LinkedList* list, int val){
 }
 
 void llist__destroy(struct LinkedList* list){
-	struct LinkedListNode* current = list->root;
+	struct LinkedListNode* current = list->arena == NULL ? list->root : NULL;
 	struct LinkedListNode* next;
 	while(current != NULL){
 		next = current->next;
@@ -139,7 +139,7 @@ void llist__destroy(struct LinkedList* list){
 }
 
 void llist__destroy_without_listanddata(struct LinkedList* list){
-	struct LinkedListNode* current = list->root;
+	struct LinkedListNode* current = list->arena == NULL ? list->root : NULL;
 	struct LinkedListNode* next;
 	while(current != NULL){
 		next = current->next;
@@ -149,7 +149,7 @@ void llist__destroy_without_listanddata(struct LinkedList* list){
 }
 
 void llist__destroy_without_data(struct LinkedList* list){
-	struct LinkedListNode* current = list->root;
+	struct LinkedListNode* current = list->arena == NULL ? list->root : NULL;
 	struct LinkedListNode* next;
 	while(current != NULL){
 		next = current->next;
@@ -0,0 +1,181 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : memory.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : Allocation of large arrays. Blocks of at least MEM_LARGE_THRESHOLD
+               bytes are mapped directly (backed by huge pages if possible) and
+               may be interleaved over NUMA nodes; smaller
+               blocks are taken from malloc.
+ ============================================================================
+ */
+
+// minimal size of a block (in bytes) to be mapped directly
+#define MEM_LARGE_THRESHOLD (2*1024*1024)
+// size of a huge page (in bytes)
+#define MEM_HUGEPAGE_SIZE (2*1024*1024)
+// every block is preceded by a header of this size (keeps 64-byte alignment)
+#define MEM_HEADER_SIZE 64
+
+#define MEM_NUMA_NONE 0
+#define MEM_NUMA_INTERLEAVE 1
+
+#define MEM_KIND_MALLOC 1
+#define MEM_KIND_MAPPED 2
+
+// policy for large blocks (set once by mem__configure())
+struct MemoryPolicy{
+  // whether to use huge pages for large blocks
+  int hugepages;
+  // one of MEM_NUMA_NONE, MEM_NUMA_INTERLEAVE
+  int numa;
+  // the number of NUMA nodes (1 if unknown)
+  int numa_nodes;
+};
+
+struct MemoryPolicy mem__policy = {TRUE, MEM_NUMA_NONE, 1};
+
+// the header in front of every block
+struct MemoryHeader{
+  // the size of the mapping (MEM_KIND_MAPPED) or the requested size (MEM_KIND_MALLOC)
+  size_t size;
+  int kind;
+};
+
+// returns the number of NUMA nodes of this machine
+int mem__numa_nodes(){
+  int nodes = 0;
+#if defined(__linux__)
+  char path[64];
+  for(;;){
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", nodes);
+    if(access(path, F_OK) != 0)
+      break;
+    nodes++;
+  }
+#endif
+  return nodes > 0 ? nodes : 1;
+}
+
+// sets the policy for large blocks
+void mem__configure(int hugepages, int numa){
+  mem__policy.hugepages = hugepages;
+  mem__policy.numa = numa;
+  mem__policy.numa_nodes = mem__numa_nodes();
+}
+
+#if defined(__linux__)
+// binds the given mapping to the NUMA nodes in "nodemask" with the given mode
+// (e.g. MPOL_INTERLEAVE = 3); failures are ignored
+void __mem__mbind(void* addr, size_t len, int mode, unsigned long nodemask){
+#if defined(SYS_mbind)
+  syscall(SYS_mbind, addr, len, mode, &nodemask, sizeof(unsigned long) * 8, 0);
+#endif
+}
+
+// maps a block of the given total size, placed according to "mode" and "nodemask"
+// (mode 0 for the default placement)
+void* __mem__map(size_t len, int mode, unsigned long nodemask){
+  void* addr = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+  if(mem__policy.hugepages){
+    size_t hlen = ((len + MEM_HUGEPAGE_SIZE - 1) / MEM_HUGEPAGE_SIZE) * MEM_HUGEPAGE_SIZE;
+    addr = mmap(NULL, hlen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(addr != MAP_FAILED)
+      len = hlen;
+  }
+#endif
+  if(addr == MAP_FAILED){
+    addr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(addr == MAP_FAILED)
+      return NULL;
+#if defined(MADV_HUGEPAGE)
+    if(mem__policy.hugepages)
+      madvise(addr, len, MADV_HUGEPAGE);
+#endif
+  }
+  if(mode != 0)
+    __mem__mbind(addr, len, mode, nodemask);
+  ((struct MemoryHeader*)addr)->size = len;
+  ((struct MemoryHeader*)addr)->kind = MEM_KIND_MAPPED;
+  return (char*)addr + MEM_HEADER_SIZE;
+}
+#endif
+
+// allocates a block of the given size (placed according to the policy)
+void* mem__alloc(size_t size){
+#if defined(__linux__)
+  if(size >= MEM_LARGE_THRESHOLD){
+    void* ptr;
+    if(mem__policy.numa == MEM_NUMA_INTERLEAVE && mem__policy.numa_nodes > 1)
+      ptr = __mem__map(size + MEM_HEADER_SIZE, 3, mem__policy.numa_nodes >= 64 ? ~0UL : (1UL << mem__policy.numa_nodes) - 1);
+    else
+      ptr = __mem__map(size + MEM_HEADER_SIZE, 0, 0);
+    if(ptr != NULL)
+      return ptr;
+  }
+#endif
+  struct MemoryHeader* header = malloc(size + MEM_HEADER_SIZE);
+  header->size = size;
+  header->kind = MEM_KIND_MALLOC;
+  return (char*)header + MEM_HEADER_SIZE;
+}
+
+// allocates a zero-initialised block for "num" elements of the given size
+void* mem__calloc(size_t num, size_t size){
+  void* ptr = mem__alloc(num * size);
+  struct MemoryHeader* header = (struct MemoryHeader*)((char*)ptr - MEM_HEADER_SIZE);
+  // fresh mappings are already zero
+  if(header->kind == MEM_KIND_MALLOC)
+    memset(ptr, 0, num * size);
+  return ptr;
+}
+
+// returns the usable size of the given block
+size_t mem__size(void* ptr){
+  struct MemoryHeader* header = (struct MemoryHeader*)((char*)ptr - MEM_HEADER_SIZE);
+  if(header->kind == MEM_KIND_MAPPED)
+    return header->size - MEM_HEADER_SIZE;
+  return header->size;
+}
+
+// frees the given block
+void mem__free(void* ptr){
+  if(ptr == NULL)
+    return;
+  struct MemoryHeader* header = (struct MemoryHeader*)((char*)ptr - MEM_HEADER_SIZE);
+#if defined(__linux__)
+  if(header->kind == MEM_KIND_MAPPED){
+    munmap(header, header->size);
+    return;
+  }
+#endif
+  free(header);
+}
+
+// resizes the given block (keeping its content)
+void* mem__realloc(void* ptr, size_t size){
+  if(ptr == NULL)
+    return mem__alloc(size);
+  struct MemoryHeader* header = (struct MemoryHeader*)((char*)ptr - MEM_HEADER_SIZE);
+  if(header->kind == MEM_KIND_MALLOC && size < MEM_LARGE_THRESHOLD){
+    header = realloc(header, size + MEM_HEADER_SIZE);
+    header->size = size;
+    return (char*)header + MEM_HEADER_SIZE;
+  }
+  size_t old_size = mem__size(ptr);
+  if(size <= old_size && header->kind == MEM_KIND_MAPPED)
+    return ptr;
+  void* new_ptr = mem__alloc(size);
+  memcpy(new_ptr, ptr, old_size < size ? old_size : size);
+  mem__free(ptr);
+  return new_ptr;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
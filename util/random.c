@@ -0,0 +1,101 @@
+/* ============================================================================================================== */
+/* == BEGIN FILE ================================================================================================ */
+/* ============================================================================================================== */
+/*
+ ============================================================================
+ Name        : random.c
+ Author      : Matthias Thimm
+ Version     : 1.0
+ Copyright   : GPL3
+ Description : A pseudo random number generator (xoshiro256** by Blackman and
+               Vigna) with explicit state, unbiased bounded sampling and
+               jump-ahead for independent streams.
+ ============================================================================
+ */
+
+/* The state of a random number generator */
+struct Rng{
+  uint64_t s[4];
+};
+
+uint64_t __rng__rotl(uint64_t x, int k){
+  return (x << k) | (x >> (64 - k));
+}
+
+/** Seeds the generator (the state is expanded from the seed by splitmix64) */
+void rng__seed(struct Rng* rng, uint64_t seed){
+  for(int i = 0; i < 4; i++){
+    uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    rng->s[i] = z ^ (z >> 31);
+  }
+}
+
+/** Returns 64 random bits */
+uint64_t rng__next(struct Rng* rng){
+  uint64_t result = __rng__rotl(rng->s[1] * 5, 7) * 9;
+  uint64_t t = rng->s[1] << 17;
+  rng->s[2] ^= rng->s[0];
+  rng->s[3] ^= rng->s[1];
+  rng->s[1] ^= rng->s[2];
+  rng->s[0] ^= rng->s[3];
+  rng->s[2] ^= t;
+  rng->s[3] = __rng__rotl(rng->s[3], 45);
+  return result;
+}
+
+/**
+ * Returns a uniformly distributed number in {0,...,bound-1} (bound > 0),
+ * using Lemire's multiply-and-reject method (no modulo bias).
+ */
+uint64_t rng__bounded(struct Rng* rng, uint64_t bound){
+  __uint128_t m = (__uint128_t)rng__next(rng) * bound;
+  uint64_t low = (uint64_t)m;
+  if(low < bound){
+    uint64_t threshold = -bound % bound;
+    while(low < threshold){
+      m = (__uint128_t)rng__next(rng) * bound;
+      low = (uint64_t)m;
+    }
+  }
+  return (uint64_t)(m >> 64);
+}
+
+/** Returns a uniformly distributed number in [0,1) */
+double rng__double(struct Rng* rng){
+  return (rng__next(rng) >> 11) * 0x1.0p-53;
+}
+
+/** Fills the given array with random words */
+void rng__fill(struct Rng* rng, uint64_t* words, long n){
+  for(long i = 0; i < n; i++)
+    words[i] = rng__next(rng);
+}
+
+/**
+ * Advances the generator by 2^128 steps; calling this repeatedly on a copy of
+ * a generator yields non-overlapping streams (e.g. for parallel walkers).
+ */
+void rng__jump(struct Rng* rng){
+  static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+  uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  for(int i = 0; i < 4; i++)
+    for(int b = 0; b < 64; b++){
+      if(JUMP[i] & (1ULL << b)){
+        s0 ^= rng->s[0];
+        s1 ^= rng->s[1];
+        s2 ^= rng->s[2];
+        s3 ^= rng->s[3];
+      }
+      rng__next(rng);
+    }
+  rng->s[0] = s0;
+  rng->s[1] = s1;
+  rng->s[2] = s2;
+  rng->s[3] = s3;
+}
+
+/* ============================================================================================================== */
+/* == END FILE ================================================================================================== */
+/* ============================================================================================================== */
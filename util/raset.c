@@ -36,15 +36,34 @@ struct RaSet* raset__init_empty(int max_number_of_elements){
   set->number_of_elements = 0;
   set->elements = malloc(sizeof(struct BitSet));
   bitset__init(set->elements,set->max_number_of_elements);
-  set->elements_arr = malloc(set->max_number_of_elements * sizeof(int));
-  set->elements_arr_inverted = malloc(set->max_number_of_elements * sizeof(int));
+  bitset__unsetAll(set->elements);
+  set->elements_arr = mem__alloc(set->max_number_of_elements * sizeof(int));
+  set->elements_arr_inverted = mem__alloc(set->max_number_of_elements * sizeof(int));
+  return set;
+}
+
+// initialises and returns a new empty raset with the given maximal number
+// of elements that is allocated from the given arena; it is released with the
+// arena and must not be destroyed
+struct RaSet* raset__init_empty_in(int max_number_of_elements, struct Arena* arena){
+  struct RaSet* set = arena__alloc(arena, sizeof(struct RaSet));
+  set->max_number_of_elements = max_number_of_elements;
+  set->number_of_elements = 0;
+  set->elements = bitset__init_in(set->max_number_of_elements, arena);
+  set->elements_arr = arena__alloc(arena, set->max_number_of_elements * sizeof(int));
+  set->elements_arr_inverted = arena__alloc(arena, set->max_number_of_elements * sizeof(int));
   return set;
 }
 
-// resets the set (removes all elements)
+// resets the set (removes all elements); if the set is small compared to
+// its membership bitset only the bits of the contained elements are cleared,
+// so resetting costs O(min(number_of_elements, max_number_of_elements/64))
 void raset__reset(struct RaSet* set){
+  if(set->number_of_elements < set->elements->num_elements){
+    for(int i = 0; i < set->number_of_elements; i++)
+      bitset__unset(set->elements,set->elements_arr[i]);
+  }else bitset__unsetAll(set->elements);
   set->number_of_elements = 0;
-  bitset__unsetAll(set->elements);
 }
 
 // return TRUE iff the element is contained in this set
@@ -77,23 +96,8 @@ int raset__remove(struct RaSet* set, int element){
 }
 
 // returns a random element from this set
-int raset__random_element(struct RaSet* set){
-    return set->elements_arr[rand() % set->number_of_elements];
-}
-
-// returns a random element from (this set MINUS the given set)
-// if there is no such element, -1 is returned
-int raset__random_element_with_skip(struct RaSet* set, struct BitSet* ignore){
-  int* arr = malloc(set->number_of_elements * sizeof(int));
-  int idx = 0;
-  for(int i = 0; i < set->number_of_elements; i++)
-    if(!bitset__get(ignore,set->elements_arr[i]))
-      arr[idx++] = set->elements_arr[i];
-  if(idx == 0)
-    return -1;
-  int result = arr[rand() % idx];
-  free(arr);
-  return result;
+int raset__random_element(struct RaSet* set, struct Rng* rng){
+    return set->elements_arr[rng__bounded(rng,set->number_of_elements)];
 }
 
 // returns the element at index position idx
@@ -104,8 +108,8 @@ int raset__get(struct RaSet* set, int idx){
 // frees the set
 void raset__destroy(struct RaSet* set){
   bitset__destroy(set->elements);
-  free(set->elements_arr);
-  free(set->elements_arr_inverted);
+  mem__free(set->elements_arr);
+  mem__free(set->elements_arr_inverted);
   free(set);
 }
 /* ============================================================================================================== */